@@ -43,6 +43,11 @@
 #define BLIS_OPTIMAL          0
 #define BLIS_UNKNOWN        202
 
+/* Return codes of createCandBranchObjects(). */
+#define BLIS_BRANCH_SET     0
+#define BLIS_BRANCH_FATHOM  1
+#define BLIS_BRANCH_TIGHTEN 2
+
 //#############################################################################
 
 enum BLIS_SOL_TYPE {
@@ -68,6 +73,7 @@ enum BLIS_BS_TYPE {
     BLIS_BS_MAXINF,
     BLIS_BS_PSEUDOCOST,
     BLIS_BS_RELIABILITY,
+    BLIS_BS_STRONG,
     BLIS_BS_SOS
 };
 
@@ -122,19 +122,32 @@ BlisBranchStrategyPseudo::betterBranchObject(BcpsBranchObject const * current,
 }
 
 void BlisBranchStrategyPseudo::update_statistics(BlisTreeNode * node) {
-  // return if this is the root node
-  if (node->getParent()==NULL) {
-    return;
-  }
   // get quality_ of this node, quality is sense*value
   double quality = node->getQuality();
-  // get quality_ of the parent node
-  double parent_quality = node->getParent()->getQuality();
-  // is this node a down or up branch
-  int dir = node->getDesc()->getBranchedDir();
+  double parent_quality;
+  int dir;
+  int branched_var;
+  double branched_value;
+  // a node that dives in place was branched on last by the dive
+  if (!node->getDiveBranch(dir, branched_var, branched_value,
+                           parent_quality)) {
+    // return if this is the root node
+    if (node->getParent()==NULL) {
+      return;
+    }
+    // get quality_ of the parent node
+    parent_quality = node->getParent()->getQuality();
+    // is this node a down or up branch
+    dir = node->getDesc()->getBranchedDir();
+    branched_var = node->getDesc()->getBranchedInd();
+    branched_value = node->getDesc()->getBranchedVal();
+  }
+  // children left behind by a dive do not know their parent bound
+  if (dir==0) {
+    return;
+  }
   // index of the branched variable for the current node
-  int branched_index = rev_relaxed_[node->getDesc()->getBranchedInd()];
-  double branched_value = node->getDesc()->getBranchedVal();
+  int branched_index = rev_relaxed_[branched_var];
 
   // update statistics
   double frac;
@@ -21,496 +21,250 @@
  * All Rights Reserved.                                                      *
  *===========================================================================*/
 
-#include "CoinHelperFunctions.hpp"
+
+#include <algorithm>
+#include <cmath>
+
 #include "CoinTime.hpp"
-#include "CoinWarmStartBasis.hpp"
 
 #include "Alps.h"
 
 #include "BlisBranchStrategyRel.h"
+#include "BlisModel.h"
 #include "BlisHelp.h"
 #include "BlisObjectInt.h"
-
-//#############################################################################
-
-struct BlisPseuoGreater
-{
-    bool operator()(double x, double y) const {
-        return (x > y);
-    }
-};
-
-//#############################################################################
-
-// Copy constructor
-BlisBranchStrategyRel::BlisBranchStrategyRel (
-    const BlisBranchStrategyRel & rhs
-    )
-    :
-    BcpsBranchStrategy()
-{
-    bestChangeUp_ = rhs.bestChangeUp_;
-    bestNumberUp_ = rhs.bestNumberUp_;
-    bestChangeDown_ = rhs.bestChangeDown_;
-    bestNumberDown_ = rhs.bestNumberDown_;
+#include "BlisTreeNode.h"
+#include "BlisBranchObjectInt.h"
+
+BlisBranchStrategyRel::BlisBranchStrategyRel(BlisModel * model, int rel):
+  BcpsBranchStrategy(model) {
+  setType(BLIS_BS_RELIABILITY);
+  relibility_ = rel;
+  // all integer variables are relaed.
+  int num_relaxed = model->getNumIntVars();
+  // fill reverse map
+  int const * relaxed_cols = model->getIntVars();
+  for (int i=0; i<num_relaxed; ++i) {
+    rev_relaxed_[relaxed_cols[i]] = i;
+  }
 }
 
-//#############################################################################
-
-/** Compare object thisOne to the bestSorFar. The compare is based on
-    pseudocost. */
-int
-BlisBranchStrategyRel::betterBranchObject(BcpsBranchObject * thisOne,
-					     BcpsBranchObject * bestSoFar)
-{
-    int betterDirection = 0;
-    double bestChange;
+BlisBranchStrategyRel::~BlisBranchStrategyRel() {
+}
 
-    if (!bestSoFar) {
-	bestChange = -1.0;
+int BlisBranchStrategyRel::createCandBranchObjects(BcpsTreeNode * node) {
+  // get node
+  BlisTreeNode * blis_node = dynamic_cast<BlisTreeNode*>(node);
+  // update statistics
+  update_statistics(blis_node);
+  // get blis model and solver
+  BlisModel * blis_model = dynamic_cast<BlisModel*>(model());
+  OsiSolverInterface * solver = blis_model->solver();
+  // get number of relaxed columns
+  // we assume all relaxed columns are integer variables.
+  int num_relaxed = blis_model->getNumIntVars();
+  // get indices of relaxed object
+  int const * relaxed = blis_model->getIntVars();
+  int num_cols = solver->getNumCols();
+  double obj_value = solver->getObjSense() * solver->getObjValue();
+  // solution is overwritten by strong branching, keep a copy.
+  double * save_solution = new double[num_cols];
+  std::copy(solver->getColSolution(), solver->getColSolution()+num_cols,
+            save_solution);
+  // store branch objects in bobjects, cand_index[k] is the index of the
+  // relaxed column bobjects[k] branches on.
+  std::vector<BcpsBranchObject*> bobjects;
+  std::vector<int> cand_index;
+  double sum_deg = 0.0;
+  // iterate over relaxed columns and populate bobjects, score them with
+  // current pseudocosts.
+  for (int i=0; i<num_relaxed; ++i) {
+    int preferredDir;
+    BcpsObject * curr_object = blis_model->getVariables()[relaxed[i]];
+    double infeasibility = curr_object->infeasibility(blis_model, preferredDir);
+    // check the amount of infeasibility
+    if (infeasibility != 0.0) {
+      BlisObjectInt * int_object =
+        dynamic_cast<BlisObjectInt*>(blis_model->objects(i));
+      double score = int_object->pseudocost().getScore();
+      sum_deg += score;
+      // create a branch object for this
+      BcpsBranchObject * cb =
+        curr_object->createBranchObject(blis_model, preferredDir);
+      cb->setScore(score);
+      bobjects.push_back(cb);
+      cand_index.push_back(i);
     }
-    else {
-        bestChange = bestChangeUp_;
+  }
+  blis_node->setSolEstimate(obj_value + sum_deg);
+
+  // strong branching may prove that a child, or both, can be dropped.
+  bool fathom = false;
+  std::vector<int> fix_ind;
+  std::vector<double> fix_lower;
+  std::vector<double> fix_upper;
+
+  // evaluate unreliable candidates with strong branching, best pseudocost
+  // first.
+  BlisParams * par = blis_model->BlisPar();
+  int max_strong = par->entry(BlisParams::strongCandSize);
+  int look_ahead = par->entry(BlisParams::lookAhead);
+  double time_limit = blis_model->AlpsPar()->entry(AlpsParams::timeLimit);
+  bool max_time_reached =
+    (CoinCpuTime() - blis_model->startTime_ > time_limit);
+  if (bobjects.size()>1 && relibility_>0 && max_strong>0 &&
+      !max_time_reached) {
+    std::vector<std::pair<double,int> > order;
+    for (size_t k=0; k<bobjects.size(); ++k) {
+      order.push_back(std::make_pair(-bobjects[k]->score(), int(k)));
     }
-
-    double upCost = thisOne->getUpScore();
-
-    if (upCost > bestChange) {
-        betterDirection = thisOne->getDirection();
-        bestChangeUp_ = upCost;
+    std::sort(order.begin(), order.end());
+    // save bounds, strong branching restores them after each solve.
+    double * save_lower = new double[num_cols];
+    double * save_upper = new double[num_cols];
+    std::copy(solver->getColLower(), solver->getColLower()+num_cols,
+              save_lower);
+    std::copy(solver->getColUpper(), solver->getColUpper()+num_cols,
+              save_upper);
+    CoinWarmStart * ws = solver->getWarmStart();
+    int save_limit;
+    solver->getIntParam(OsiMaxNumIterationHotStart, save_limit);
+    int max_iter = std::max(blis_model->getAveIterations(), 50);
+    solver->setIntParam(OsiMaxNumIterationHotStart, max_iter);
+    solver->markHotStart();
+    double best_score = -ALPS_DBL_MAX;
+    int num_strong = 0;
+    int num_not_better = 0;
+    for (size_t j=0; j<order.size(); ++j) {
+      if (num_strong>=max_strong ||
+          (look_ahead>0 && num_not_better>=look_ahead)) {
+        break;
+      }
+      int k = order[j].second;
+      int i = cand_index[k];
+      BlisObjectInt * int_object =
+        dynamic_cast<BlisObjectInt*>(blis_model->objects(i));
+      BlisPseudocost & pseudo = int_object->pseudocost();
+      int count = std::min(pseudo.getDownCount(), pseudo.getUpCount());
+      if (count>=relibility_) {
+        // pseudocost is reliable, score is already set.
+        continue;
+      }
+      int col = relaxed[i];
+      double x = save_solution[col];
+      bool down_keep, down_finished, up_keep, up_finished;
+      double down_deg, up_deg;
+      BlisStrongBranch(blis_model, obj_value, col, x,
+                       save_lower, save_upper,
+                       down_keep, down_finished, down_deg,
+                       up_keep, up_finished, up_deg);
+      ++num_strong;
+      if (down_finished) {
+        pseudo.update(-1, down_deg, x);
+      }
+      if (up_finished) {
+        pseudo.update(1, up_deg, x);
+      }
+      if (!down_keep && !up_keep) {
+        // neither child can hold a better solution.
+        fathom = true;
+        break;
+      }
+      if (!down_keep || !up_keep) {
+        // only one child is left, the node becomes that child instead of
+        // branching into a dead one.
+        fix_ind.push_back(col);
+        fix_lower.push_back(down_keep ? save_lower[col] : ceil(x));
+        fix_upper.push_back(down_keep ? floor(x) : save_upper[col]);
+        continue;
+      }
+      double score = pseudo.getScore();
+      bobjects[k]->setScore(score);
+      if (score>best_score) {
+        best_score = score;
+        num_not_better = 0;
+      }
+      else {
+        num_not_better++;
+      }
     }
-
-    return betterDirection;
+    solver->unmarkHotStart();
+    solver->setColSolution(save_solution);
+    solver->setIntParam(OsiMaxNumIterationHotStart, save_limit);
+    solver->setWarmStart(ws);
+    delete ws;
+    // the hot start leaves the solver in the state of the last strong
+    // branching solve, resolve from the saved basis so that the node lp
+    // is optimal again for the rest of the node processing.
+    solver->resolve();
+    delete[] save_lower;
+    delete[] save_upper;
+  }
+  delete[] save_solution;
+  // add branch objects to branchObjects_
+  setBranchObjects(bobjects);
+  // bobjects are now owned by BcpsBranchStrategy, do not free them.
+  bobjects.clear();
+  if (fathom) {
+    return BLIS_BRANCH_FATHOM;
+  }
+  if (!fix_ind.empty()) {
+    blis_node->tightenColBounds(blis_model, int(fix_ind.size()), &fix_ind[0],
+                                &fix_lower[0], &fix_upper[0]);
+    return BLIS_BRANCH_TIGHTEN;
+  }
+  // set the branch object member of the node
+  blis_node->setBranchObject(new BlisBranchObjectInt(bestBranchObject()));
+  return BLIS_BRANCH_SET;
 }
 
-//#############################################################################
-
-/** Create a set of candidate branching objects. */
 int
-BlisBranchStrategyRel::createCandBranchObjects(int numPassesLeft)
-{
-    int bStatus = 0;
-    int i, pass, colInd;
-
-    int preferDir, saveLimit;
-    int numFirsts  = 0;
-    int numInfs = 0;
-    int minCount = 0;
-    int numLowerTightens = 0;
-    int numUpperTightens = 0;
-
-    double lpX, score, infeasibility, downDeg, upDeg, sumDeg = 0.0;
-
-    bool roundAgain, downKeep, downGood, upKeep, upGood;
-
-
-    int *lbInd = NULL;
-    int *ubInd = NULL;
-    double *newLB = NULL;
-    double *newUB = NULL;
-
-    double * saveUpper = NULL;
-    double * saveLower = NULL;
-    double * saveSolution = NULL;
-
-
-    BlisModel *model = dynamic_cast<BlisModel *>(model_);
-    OsiSolverInterface * solver = model->solver();
-
-    int numCols = model->getNumCols();
-    int numObjects = model->numObjects();
-
-    //int lookAhead = dynamic_cast<BlisParams*>
-    //  (model->blisPar())->entry(BlisParams::lookAhead);
-
-    //------------------------------------------------------
-    // Check if max time is reached or no pass is left.
-    //------------------------------------------------------
-
-    double timeLimit = model->AlpsPar()->entry(AlpsParams::timeLimit);
-    bool maxTimeReached = (CoinCpuTime() - model->startTime_  > timeLimit);
-    bool selectNow = false;
-
-    if (maxTimeReached || !numPassesLeft) {
-        selectNow = true;
-#ifdef BLIS_DEBUG
-        printf("REL: CREATE: maxTimeReached %d, numPassesLeft %d\n",
-               maxTimeReached, numPassesLeft);
-#endif
-    }
-
-
-    // Store first time objects.
-    std::vector<BlisObjectInt *> firstObjects;
-
-    // Store infeasible objects.
-    std::vector<BlisObjectInt *> infObjects;
-
-    // TODO: check if sorting is expensive.
-    std::multimap<double, BlisObjectInt*, BlisPseuoGreater> sortedObjects;
-
-    double objValue = solver->getObjSense() * solver->getObjValue();
-
-    const double * lower = solver->getColLower();
-    const double * upper = solver->getColUpper();
-
-    int lookAhead = dynamic_cast<BlisParams*>
-	(model->BlisPar())->entry(BlisParams::lookAhead);
-
-    BlisObjectInt * intObject = NULL;
-
-    //------------------------------------------------------
-    // Backup solver status and mark hot start.
-    //-----------------------------------------------------
-
-    saveSolution = new double[numCols];
-    memcpy(saveSolution, solver->getColSolution(), numCols*sizeof(double));
-    saveLower = new double[numCols];
-    saveUpper = new double[numCols];
-    memcpy(saveLower, lower, numCols * sizeof(double));
-    memcpy(saveUpper, upper, numCols * sizeof(double));
-
-    //------------------------------------------------------
-    // Find the infeasible objects.
-    // NOTE: we might go round this loop twice if we are feed in
-    //       a "feasible" solution.
-    //------------------------------------------------------
-
-    for (pass = 0; pass < 2; ++pass) {
-
-        numInfs = 0;
-
-        BcpsObject * object = NULL;
-
-
-        infObjects.clear();
-        firstObjects.clear();
-
-        for (i = 0; i < numObjects; ++i) {
-
-            object = model->objects(i);
-            infeasibility = object->infeasibility(model, preferDir);
-
-            if (infeasibility) {
-
-                ++numInfs;
-                intObject = dynamic_cast<BlisObjectInt *>(object);
-
-                if (intObject) {
-
-                    //score = object->pseudocost().getScore();
-                    //tempBO = object->createBranchObject(model, preferDir);
-                    //candObjects.insert(std::make_pair(score, tempBO));
-                    //tempBO = NULL;
-
-                    infObjects.push_back(intObject);
-
-                    if (!selectNow) {
-                        minCount =
-                            ALPS_MIN(intObject->pseudocost().getDownCount(),
-                                     intObject->pseudocost().getUpCount());
-
-                        if (minCount < 1) {
-                            firstObjects.push_back(intObject);
-                        }
-                    }
-
-#ifdef BLIS_DEBUG_MORE
-                    if (intObject->columnIndex() == 15) {
-                        std::cout << "x[15] = " << saveSolution[15]
-                                  << std::endl;
-                    }
-#endif
-
-                    intObject = NULL;
-                }
-                else {
-                    // TODO: currently all are integer objects.
-#ifdef BLIS_DEBU
-                    assert(0);
-#endif
-                }
-
-            }
-        }
-
-        if (numInfs) {
-#ifdef BLIS_DEBUG_MORE
-            std::cout << "REL: numInfs = " << numInfs
-                      << std::endl;
-#endif
-            break;
-        }
-        else if (pass == 0) {
-            // The first pass and is IP feasible.
-
-#ifdef BLIS_DEBUG
-            std::cout << "REL: given a feasible sol" << std::endl;
-#endif
-
-            roundAgain = false;
-            CoinWarmStartBasis * ws =
-                dynamic_cast<CoinWarmStartBasis*>(solver->getWarmStart());
-            if (!ws) break;
-
-            // Force solution values within bounds
-            for (i = 0; i < numCols; ++i) {
-                lpX = saveSolution[i];
-                if (lpX < lower[i]) {
-                    saveSolution[i] = lower[i];
-                    roundAgain = true;
-                    ws->setStructStatus(i, CoinWarmStartBasis::atLowerBound);
-                }
-                else if (lpX > upper[i]) {
-                    saveSolution[i] = upper[i];
-                    roundAgain = true;
-                    ws->setStructStatus(i, CoinWarmStartBasis::atUpperBound);
-                }
-            }
-
-            if (roundAgain) {
-                // Need resolve and do the second round selection.
-                solver->setWarmStart(ws);
-                delete ws;
-
-                // Resolve.
-                solver->resolve();
-
-                if (!solver->isProvenOptimal()) {
-                    // Become infeasible, can do nothing.
-                    bStatus = -2;
-                    goto TERM_CREATE;
-                }
-                else {
-                    // Save new lp solution.
-                    memcpy(saveSolution, solver->getColSolution(),
-                           numCols * sizeof(double));
-                    objValue = solver->getObjSense() * solver->getObjValue();
-                }
-            }
-            else {
-                delete ws;
-                break;
-            }
-        }
-    } // EOF 2 pass
-
-    //--------------------------------------------------
-    // If we have a set of first time object,
-    // branch up and down to initialize pseudo-cost.
-    //--------------------------------------------------
-
-    numFirsts = static_cast<int> (firstObjects.size());
-    if (numFirsts > 0) {
-
-        CoinWarmStart * ws = solver->getWarmStart();
-        solver->getIntParam(OsiMaxNumIterationHotStart, saveLimit);
-	int maxIter = ALPS_MAX(model->getAveIterations(), 50);
-        solver->setIntParam(OsiMaxNumIterationHotStart, maxIter);
-
-        solver->markHotStart();
-
-        lbInd = new int [numFirsts];
-        ubInd = new int [numFirsts];
-
-        newLB = new double [numFirsts];
-        newUB = new double [numFirsts];
-
-        for (i = 0; i < numFirsts && bStatus != -2; ++i) {
-
-            colInd = firstObjects[i]->columnIndex();
-
-            lpX = saveSolution[colInd];
-
-            BlisStrongBranch(model, objValue, colInd, lpX,
-                             saveLower, saveUpper,
-                             downKeep, downGood, downDeg,
-                             upKeep, upGood, upDeg);
-
-            if(!downKeep && !upKeep) {
-                // Both branch can be fathomed
-                bStatus = -2;
-            }
-            else if (!downKeep) {
-                // Down branch can be fathomed.
-                lbInd[numLowerTightens] = colInd;
-                newLB[numLowerTightens++] = ceil(lpX);
-                //break;
-            }
-            else if (!upKeep) {
-                // Up branch can be fathomed.
-                ubInd[numUpperTightens] = colInd;
-                newUB[numUpperTightens++] = floor(lpX);
-                // break;
-            }
-
-            // Update pseudocost.
-            if(downGood) {
-                firstObjects[i]->pseudocost().update(-1, downDeg, lpX);
-            }
-            if(downGood) {
-                firstObjects[i]->pseudocost().update(1, upDeg, lpX);
-            }
-        }
-
-        //--------------------------------------------------
-        // Set new bounds in lp solver for resolving
-        //--------------------------------------------------
-
-        if (bStatus != -2) {
-            if (numUpperTightens > 0) {
-                bStatus = -1;
-                for (i = 0; i < numUpperTightens; ++i) {
-                    solver->setColUpper(ubInd[i], newUB[i]);
-                }
-            }
-            if (numLowerTightens > 0) {
-                bStatus = -1;
-                for (i = 0; i < numLowerTightens; ++i) {
-                    solver->setColLower(lbInd[i], newLB[i]);
-                }
-            }
-        }
-
-        //--------------------------------------------------
-        // Unmark hotstart and recover LP solver.
-        //--------------------------------------------------
-
-        solver->unmarkHotStart();
-        solver->setColSolution(saveSolution);
-        solver->setIntParam(OsiMaxNumIterationHotStart, saveLimit);
-        solver->setWarmStart(ws);
-        delete ws;
-    }
-
-    //std::cout << "REL: bStatus = " << bStatus << std::endl;
-
-    if (bStatus < 0) {
-        // Infeasible or monotone.
-	goto TERM_CREATE;
-    }
-    else {
-        // All object's pseudocost have been initialized.
-        // Sort them, and do strong branch for the unreliable one
-        // NOTE: it set model->savedLpSolution.
-	// model->feasibleSolution(numIntegerInfs, numObjectInfs);
-
-        sumDeg = 0.0;
-
-        for (i = 0; i < numInfs; ++i) {
-            score = infObjects[i]->pseudocost().getScore();
-            sumDeg += score;
-
-	    std::pair<const double, BlisObjectInt*> sa(score, infObjects[i]);
-	    sortedObjects.insert(sa);
-
-#ifdef BLIS_DEBUG_MORE
-            std::cout << "col[" << infObjects[i]->columnIndex() << "]="
-                      << score << ", "<< std::endl;
-#endif
-        }
-
-        int numNotChange = 0;
-
-        std::multimap< double, BlisObjectInt*, BlisPseuoGreater >::iterator pos;
-
-        CoinWarmStart * ws = solver->getWarmStart();
-        solver->getIntParam(OsiMaxNumIterationHotStart, saveLimit);
-	int maxIter = ALPS_MAX(model->getAveIterations(), 50);
-        solver->setIntParam(OsiMaxNumIterationHotStart, maxIter);
-        solver->markHotStart();
-
-        BlisObjectInt *bestObject = NULL;
-        double bestScore = -10.0;
-
-        for (pos = sortedObjects.begin(); pos != sortedObjects.end(); ++pos) {
-
-	    intObject  = pos->second;
-
-            colInd = intObject->columnIndex();
-
-#ifdef BLIS_DEBUG_MORE
-            std::cout << "col[" << colInd << "]: "
-                      << "score=" << pos->first
-                      << ", upCount=" << intObject->pseudocost().getUpCount()
-                      <<", downCount="<< intObject->pseudocost().getDownCount()
-                      << std::endl;
-#endif
-
-            // Check if reliable.
-	    int objRelibility=ALPS_MIN(intObject->pseudocost().getUpCount(),
-                                       intObject->pseudocost().getDownCount());
-
-            if (objRelibility < relibility_) {
-		// Unrelible object. Do strong branching.
-
-
-                lpX = saveSolution[colInd];
-
-                BlisStrongBranch(model, objValue, colInd, lpX,
-                                 saveLower, saveUpper,
-                                 downKeep, downGood, downDeg,
-                                 upKeep, upGood, upDeg);
-                // Update pseudocost.
-                if(downGood) {
-                    intObject->pseudocost().update(-1, downDeg, lpX);
-                }
-                if(downGood) {
-                    intObject->pseudocost().update(1, upDeg, lpX);
-                }
-	    }
-
-            // Compare with the best.
-            if (intObject->pseudocost().getScore() > bestScore) {
-                bestScore = intObject->pseudocost().getScore();
-                bestObject = intObject;
-                // Reset
-                numNotChange = 0;
-            }
-	    else {
-                // If best doesn't change for "lookAhead" comparisons, then
-                // the best is reliable.
-		if (++numNotChange > lookAhead) {
-                    if (bestObject->pseudocost().getUpCost() >
-                        bestObject->pseudocost().getDownCost()) {
-                        preferDir = 1;
-                    }
-                    else {
-                        preferDir = -1;
-                    }
-                    break;
-                }
-	    }
-        }
-
-        solver->unmarkHotStart();
-        solver->setColSolution(saveSolution);
-        solver->setIntParam(OsiMaxNumIterationHotStart, saveLimit);
-        solver->setWarmStart(ws);
-        delete ws;
-
-        model->setSolEstimate(objValue + sumDeg);
+BlisBranchStrategyRel::betterBranchObject(BcpsBranchObject const * current,
+                                          BcpsBranchObject const * other) {
+  int res;
+  if (current->score()>other->score()) {
+    res = 1;
+  }
+  else {
+    res = 0;
+  }
+  return res;
+}
 
-        assert(bestObject != NULL);
-        bestBranchObject_ = bestObject->createBranchObject(model, preferDir);
+void BlisBranchStrategyRel::update_statistics(BlisTreeNode * node) {
+  // get quality_ of this node, quality is sense*value
+  double quality = node->getQuality();
+  double parent_quality;
+  int dir;
+  int branched_var;
+  double branched_value;
+  // a node that dives in place was branched on last by the dive
+  if (!node->getDiveBranch(dir, branched_var, branched_value,
+                           parent_quality)) {
+    // return if this is the root node
+    if (node->getParent()==NULL) {
+      return;
     }
-
-
- TERM_CREATE:
-
-    //------------------------------------------------------
-    // Cleanup.
-    //------------------------------------------------------
-
-    delete [] lbInd;
-    delete [] ubInd;
-    delete [] newLB;
-    delete [] newUB;
-    delete [] saveSolution;
-    delete [] saveLower;
-    delete [] saveUpper;
-
-    return bStatus;
+    // get quality_ of the parent node
+    parent_quality = node->getParent()->getQuality();
+    // is this node a down or up branch
+    dir = node->getDesc()->getBranchedDir();
+    branched_var = node->getDesc()->getBranchedInd();
+    branched_value = node->getDesc()->getBranchedVal();
+  }
+  // children left behind by a dive do not know their parent bound
+  if (dir==0) {
+    return;
+  }
+  if (dir!=-1 && dir!=1) {
+    std::cerr << "Invalid branching direction!" << std::endl;
+    throw std::exception();
+  }
+  // index of the branched variable for the current node
+  int branched_index = rev_relaxed_[branched_var];
+  BlisModel * blis_model = dynamic_cast<BlisModel*>(model());
+  BlisObjectInt * int_object =
+    dynamic_cast<BlisObjectInt*>(blis_model->objects(branched_index));
+  int_object->pseudocost().update(dir, quality-parent_quality,
+                                  branched_value);
 }
-
-//#############################################################################
@@ -34,54 +34,43 @@
 #include "BcpsBranchStrategy.h"
 #include "BlisModel.h"
 
+class BlisTreeNode;
 
-/** Blis branching strategy default class
-    This class implements a simple default algorithm, betterBranchObject(),
-    for choosing a branching variable. */
-class BlisBranchStrategyRel : public BcpsBranchStrategy {
-
- private:
-    /** Illegal Assignment operator.*/
-    BlisBranchStrategyRel& operator=(const BlisBranchStrategyRel& rhs);
 
+/** Blis reliability branching strategy.
+    Candidates are ranked by pseudocost. Pseudocosts of a variable are
+    considered reliable once the variable has been branched on at least
+    relibility_ times in both directions. Unreliable candidates are
+    evaluated with strong branching, at most strongCandSize of them and
+    until lookAhead consecutive evaluations fail to improve the best score.
+*/
+class BlisBranchStrategyRel : public BcpsBranchStrategy {
+    /// Number of observations needed before a pseudocost is trusted.
     int relibility_;
+    /// reverse map of relaxed columns, rev_relaxed_[index] gives the index of
+    /// the varaible in relaxed columns array.
+    std::map<int,int> rev_relaxed_;
+    /// update pseudocost of the variable branched on to create node.
+    void update_statistics(BlisTreeNode * node);
 
  public:
-
-    /** Default Constructor. */
-    BlisBranchStrategyRel() : relibility_(1) {}
-
-    /** Useful Constructor. */
-    BlisBranchStrategyRel(BlisModel *model, int rel)
-        :
-        BcpsBranchStrategy(model),
-        relibility_(rel)
-        {}
-
-    /** Destructor. */
-    virtual ~BlisBranchStrategyRel() {}
-
-    /** Copy constructor. */
-    BlisBranchStrategyRel(const BlisBranchStrategyRel &);
-
-    /** Set relibility. */
-    void setRelibility(int rel) { relibility_ = rel; }
-
-    /** Clone a brancing strategy. */
-    virtual BcpsBranchStrategy * clone() const {
-	return new BlisBranchStrategyRel(*this);
-    }
-
-    /** Compare branching object thisOne to bestSoFar. If thisOne is better
-	than bestObject, return branching direction(1 or -1), otherwise
-	return 0.
-	If bestSorFar is NULL, then always return branching direction(1 or -1).
-    */
-    virtual int betterBranchObject(BcpsBranchObject * thisOne,
-				   BcpsBranchObject * bestSoFar);
-
-    /** Create a set of candidate branching objects. */
-    int createCandBranchObjects(int numPassesLeft);
+  BlisBranchStrategyRel(BlisModel * model, int rel);
+  virtual ~BlisBranchStrategyRel();
+  /// Get reliability threshold.
+  int getRelibility() const { return relibility_; }
+  /// Set reliability threshold.
+  void setRelibility(int rel) { relibility_ = rel; }
+  virtual int createCandBranchObjects(BcpsTreeNode * node);
+  /// Compare current to other, return 1 if current is better, 0 otherwise
+  virtual int betterBranchObject(BcpsBranchObject const * current,
+                                 BcpsBranchObject const * other);
+private:
+  /// Disable default constructor.
+  BlisBranchStrategyRel();
+  /// Disable copy constructor.
+  BlisBranchStrategyRel(BlisBranchStrategyRel const & other);
+  /// Disable copy assignment operator.
+  BlisBranchStrategyRel & operator=(BlisBranchStrategyRel const & rhs);
 };
 
 #endif
@@ -34,66 +34,35 @@
 #include "BcpsBranchStrategy.h"
 #include "BlisModel.h"
 
-
-//#############################################################################
-
-
-typedef struct {
-    int objectIndex;            // object index
-    BcpsBranchObject * bObject; // the branching object
-    int numIntInfUp;            // without odd ones
-    int numObjInfUp;            // just odd ones
-    bool finishedUp;            // true if solver finished
-    int numIntInfDown;          // without odd ones
-    int numObjInfDown;          // just odd ones
-    bool finishedDown;          // true if solver finished
-} BlisStrong;
+class BlisTreeNode;
 
 
-//#############################################################################
-
-
-/** Blis branching strategy default class
-    This class implements a simple default algorithm, betterBranchObject(),
-    for choosing a branching variable. */
+/** Blis strong branching strategy.
+    The strongCandSize most fractional variables are evaluated by solving
+    both children with a limited number of dual simplex iterations. The
+    score of a candidate is
+    \f$ w \min(\Delta^-, \Delta^+) + (1-w) \max(\Delta^-, \Delta^+) \f$
+    where \f$ \Delta \f$ are the objective degradations and w is
+    pseudoWeight. Candidates with a child that can be pruned are preferred.
+*/
 class BlisBranchStrategyStrong : public BcpsBranchStrategy {
-
- private:
-
-    /** Illegal Assignment operator.*/
-    BlisBranchStrategyStrong& operator=(const BlisBranchStrategyStrong& rhs);
+    /// weight of the smaller degradation in the score.
+    double score_factor_;
 
  public:
-
-    /** Strong Constructor. */
-    BlisBranchStrategyStrong() {}
-
-    /** Strong Constructor. */
-    BlisBranchStrategyStrong(BlisModel *model)
-        : BcpsBranchStrategy(model)
-        {}
-
-    /** Destructor. */
-    virtual ~BlisBranchStrategyStrong() {}
-
-    /** Copy constructor. */
-    BlisBranchStrategyStrong(const BlisBranchStrategyStrong &);
-
-    /** Clone a brancing strategy. */
-    virtual BcpsBranchStrategy * clone() const {
-	return new BlisBranchStrategyStrong(*this);
-    }
-
-    /** Create a set of candidate branching objects. */
-    virtual int createCandBranchObjects(int numPassesLeft);
-
-    /** Compare branching object thisOne to bestSoFar. If thisOne is better
-	than bestObject, return branching direction(1 or -1), otherwise
-	return 0.
-	If bestSorFar is NULL, then always return branching direction(1 or -1).
-    */
-    virtual int betterBranchObject(BcpsBranchObject * thisOne,
-				   BcpsBranchObject * bestSoFar);
+  BlisBranchStrategyStrong(BlisModel * model);
+  virtual ~BlisBranchStrategyStrong();
+  virtual int createCandBranchObjects(BcpsTreeNode * node);
+  /// Compare current to other, return 1 if current is better, 0 otherwise
+  virtual int betterBranchObject(BcpsBranchObject const * current,
+                                 BcpsBranchObject const * other);
+private:
+  /// Disable default constructor.
+  BlisBranchStrategyStrong();
+  /// Disable copy constructor.
+  BlisBranchStrategyStrong(BlisBranchStrategyStrong const & other);
+  /// Disable copy assignment operator.
+  BlisBranchStrategyStrong & operator=(BlisBranchStrategyStrong const & rhs);
 };
 
 #endif
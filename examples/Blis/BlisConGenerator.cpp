@@ -187,18 +187,33 @@ BlisConGenerator::generateCons(OsiCuts & coinCuts , bool fullScan)
 
             int numberColumns = solver->getNumCols();
             double primalTolerance = 1.0e-8;
+
+            // Collect fixings first; lower/upper point into the solver.
+            int numFix = 0;
+            int *fixInd = new int [numberColumns];
+            double *fixBounds = new double [2 * numberColumns];
+
             for (j = 0; j < numberColumns; ++j) {
                 if ( (tightUpper[j] == tightLower[j]) &&
                      (upper[j] > lower[j]) ) {
                     // fix column j
-                    solver->setColLower(j, tightLower[j]);
-                    solver->setColUpper(j, tightUpper[j]);
+                    fixInd[numFix] = j;
+                    fixBounds[2 * numFix] = tightLower[j];
+                    fixBounds[2 * numFix + 1] = tightUpper[j];
+                    ++numFix;
                     if ( (tightLower[j] > solution[j] + primalTolerance) ||
                          (tightUpper[j] < solution[j] - primalTolerance) ) {
                         status = true;
                     }
                 }
             }
+
+            if (numFix > 0) {
+                solver->setColSetBounds(fixInd, fixInd + numFix, fixBounds);
+            }
+
+            delete [] fixInd;
+            delete [] fixBounds;
         } // EOF probing.
 
         //--------------------------------------------------
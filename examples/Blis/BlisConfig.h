@@ -0,0 +1,43 @@
+/*===========================================================================*
+ * This file is part of the Bcps Linear Solver (BLIS).                       *
+ *                                                                           *
+ * BLIS is distributed under the Eclipse Public License as part of the       *
+ * COIN-OR repository (http://www.coin-or.org).                              *
+ *                                                                           *
+ * Authors:                                                                  *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *                                                                           *
+ * Conceptual Design:                                                        *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *          Laszlo Ladanyi, IBM T.J. Watson Research Center                  *
+ *          Matthew Saltzman, Clemson University                             *
+ *                                                                           *
+ *                                                                           *
+ * Copyright (C) 2001-2017, Lehigh University, Yan Xu, and Ted Ralphs.       *
+ * All Rights Reserved.                                                      *
+ *===========================================================================*/
+
+
+/* Include file for the configuration of the Blis example.
+ *
+ * When the example is built with the configure script (HAVE_CONFIG_H
+ * defined), this includes config_blis.h, which configure generates from
+ * config_blis.h.in with the system facilities it found. Otherwise (e.g.,
+ * with the Developer Studio) config_blis_default.h is included, which
+ * assumes none of them; Blis then uses its portable fallbacks.
+ */
+
+#ifndef BlisConfig_h_
+#define BlisConfig_h_
+
+#ifdef HAVE_CONFIG_H
+#include "config_blis.h"
+#else
+#include "config_blis_default.h"
+#endif
+
+#endif
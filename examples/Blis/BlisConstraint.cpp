@@ -21,6 +21,9 @@
  * All Rights Reserved.                                                      *
  *===========================================================================*/
 
+#include <cassert>
+#include <vector>
+
 #include "BlisConstraint.h"
 #include "BlisModel.h"
 
@@ -102,40 +105,107 @@ BlisConstraint::BlisConstraint(const BlisConstraint & rhs)
 
 double BlisConstraint::infeasibility(BcpsModel * m,
                                      int & preferredWay) const {
-  std::cerr << "Not implemented, " << std::endl
-            << "file: " <<  __FILE__ << std::endl
-            << "line: " << __LINE__ << std::endl;
-  throw std::exception();
-  return 0.0;
+    BlisModel * model = dynamic_cast<BlisModel *>(m);
+    const double * solution = model->solver()->getColSolution();
+
+    double activity = 0.0;
+    for (int k = 0; k < size_; ++k) {
+        activity += values_[k] * solution[indices_[k]];
+    }
+
+    preferredWay = 0;
+    if (activity < lbHard_) {
+        preferredWay = -1;
+        return lbHard_ - activity;
+    }
+    else if (activity > ubHard_) {
+        preferredWay = 1;
+        return activity - ubHard_;
+    }
+    return 0.0;
 }
 
-/// Encode this to an AlpsEncoded object.
-AlpsReturnStatus BlisConstraint::encode(AlpsEncoded * encoded) {
-  std::cerr << "Not implemented, " << std::endl
-            << "file: " <<  __FILE__ << std::endl
-            << "line: " << __LINE__ << std::endl;
-  throw std::exception();
-  return AlpsReturnStatusOk;
+//#############################################################################
+
+/** Indices are written as differences to the previous index, zigzag mapped
+    to unsigned and packed 7 bits per byte. Cut indices are usually sorted,
+    so most of them take one byte. */
+AlpsReturnStatus BlisConstraint::encode(AlpsEncoded * encoded) const {
+    AlpsReturnStatus status = encodeBcpsObject(encoded);
+
+    std::vector<char> bytes;
+    bytes.reserve(size_ + 4);
+    int prev = 0;
+    for (int k = 0; k < size_; ++k) {
+        int delta = indices_[k] - prev;
+        unsigned int code = (static_cast<unsigned int>(delta) << 1) ^
+            static_cast<unsigned int>(delta >> 31);
+        while (code >= 0x80) {
+            bytes.push_back(static_cast<char>((code & 0x7f) | 0x80));
+            code >>= 7;
+        }
+        bytes.push_back(static_cast<char>(code));
+        prev = indices_[k];
+    }
+
+    encoded->writeRep(size_);
+    encoded->writeRep(bytes.empty() ? NULL : &bytes[0],
+                      static_cast<int>(bytes.size()));
+    encoded->writeRep(values_, size_);
+
+    return status;
 }
 
+//#############################################################################
+
 /// Decode a given AlpsEncoded object to an AlpsKnowledge object and return a
 /// pointer to it.
 AlpsKnowledge * BlisConstraint::decode(AlpsEncoded & encoded) const {
-  std::cerr << "Not implemented, " << std::endl
-            << "file: " <<  __FILE__ << std::endl
-            << "line: " << __LINE__ << std::endl;
-  throw std::exception();
-  BlisConstraint * con = new BlisConstraint();
-  return con;
+    BlisConstraint * con = new BlisConstraint();
+    con->decodeToSelf(encoded);
+    return con;
 }
 
+//#############################################################################
+
 /// Decode a given AlpsEncoded object into self.
 AlpsReturnStatus BlisConstraint::decodeToSelf(AlpsEncoded & encoded) {
-  std::cerr << "Not implemented, " << std::endl
-            << "file: " <<  __FILE__ << std::endl
-            << "line: " << __LINE__ << std::endl;
-  throw std::exception();
-  return AlpsReturnStatusOk;
+    AlpsReturnStatus status = decodeBcpsObject(encoded);
+
+    delete [] indices_; indices_ = NULL;
+    delete [] values_; values_ = NULL;
+
+    int numBytes = 0;
+    char * bytes = NULL;
+    encoded.readRep(size_);
+    encoded.readRep(bytes, numBytes);
+
+    if (size_ > 0) {
+        indices_ = new int [size_];
+    }
+    int prev = 0;
+    int pos = 0;
+    for (int k = 0; k < size_; ++k) {
+        unsigned int code = 0;
+        int shift = 0;
+        unsigned char byte;
+        do {
+            assert(pos < numBytes);
+            byte = static_cast<unsigned char>(bytes[pos++]);
+            code |= static_cast<unsigned int>(byte & 0x7f) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+        int delta = static_cast<int>(code >> 1) ^ -static_cast<int>(code & 1);
+        prev += delta;
+        indices_[k] = prev;
+    }
+    delete [] bytes;
+
+    int numValues = 0;
+    encoded.readRep(values_, numValues);
+    assert(numValues == size_);
+
+    return status;
 }
 
 //#############################################################################
@@ -78,12 +78,23 @@ class BlisConstraint : public BcpsConstraint {
     }
     /**@}*/
 
+    /** Return the violation of the row by the current lp solution, 0.0 if
+        it is satisfied. preferredWay is -1 if the activity is below the
+        lower bound, 1 if above. */
     virtual double infeasibility(BcpsModel * m, int & preferredWay) const;
 
+    /** Return the memory used by the constraint and its coefficients. */
+    virtual size_t getMemoryUsage() const {
+        return sizeof(BlisConstraint) + size_ * (sizeof(int) + sizeof(double));
+    }
+
     ///@name Encode and Decode functions
     //@{
-    /// Encode this to an AlpsEncoded object.
-    virtual AlpsReturnStatus encode(AlpsEncoded * encoded);
+    /// Get encode from #AlpsKnowledge
+    using AlpsKnowledge::encode;
+    /// Encode this to an AlpsEncoded object. The row indices are delta
+    /// coded into variable length bytes.
+    virtual AlpsReturnStatus encode(AlpsEncoded * encoded) const;
     /// Decode a given AlpsEncoded object to an AlpsKnowledge object and return a
     /// pointer to it.
     virtual AlpsKnowledge * decode(AlpsEncoded & encoded) const;
@@ -26,6 +26,7 @@
 #include "CoinWarmStartBasis.hpp"
 
 #include "OsiRowCut.hpp"
+#include "OsiSolverInterface.hpp"
 
 #include "AlpsKnowledgeBroker.h"
 
@@ -33,6 +34,7 @@
 #include "BlisConstraint.h"
 #include "BlisModel.h"
 #include "BlisSolution.h"
+#include "BlisSolutionPool.h"
 
 //#############################################################################
 
@@ -87,6 +89,50 @@ OsiRowCut * BlisConstraintToOsiCut(const BlisConstraint * con)
 
 //#############################################################################
 
+/** Add constraints to the lp solver as one block of rows. */
+void BlisAddConstraintsToSolver(OsiSolverInterface *solver,
+                                int numCons,
+                                BlisConstraint * const *cons)
+{
+    int k;
+    CoinBigIndex numElems = 0;
+
+    if (numCons <= 0) return;
+
+    for (k = 0; k < numCons; ++k) {
+        assert(cons[k]->getSize() > 0);
+        numElems += cons[k]->getSize();
+    }
+
+    CoinBigIndex *rowStarts = new CoinBigIndex [numCons + 1];
+    int *columns = new int [numElems];
+    double *elements = new double [numElems];
+    double *rowLB = new double [numCons];
+    double *rowUB = new double [numCons];
+
+    // Assemble the block in row ordered (CSR) format.
+    rowStarts[0] = 0;
+    for (k = 0; k < numCons; ++k) {
+        const BlisConstraint *con = cons[k];
+        int size = con->getSize();
+        CoinDisjointCopyN(con->getIndices(), size, columns + rowStarts[k]);
+        CoinDisjointCopyN(con->getValues(), size, elements + rowStarts[k]);
+        rowStarts[k+1] = rowStarts[k] + size;
+        rowLB[k] = CoinMax(con->getLbHard(), con->getLbSoft());
+        rowUB[k] = CoinMin(con->getUbHard(), con->getUbSoft());
+    }
+
+    solver->addRows(numCons, rowStarts, columns, elements, rowLB, rowUB);
+
+    delete [] rowStarts;
+    delete [] columns;
+    delete [] elements;
+    delete [] rowLB;
+    delete [] rowUB;
+}
+
+//#############################################################################
+
 int BlisStrongBranch(BlisModel *model, double objValue, int colInd, double x,
                      const double *saveLower, const double *saveUpper,
 		     bool &downKeep, bool &downFinished, double &downDeg,
@@ -95,22 +141,20 @@ int BlisStrongBranch(BlisModel *model, double objValue, int colInd, double x,
     int status = BLIS_OK;
     int lpStatus = 0;
 
-    int j, numIntInfDown, numObjInfDown;
+    int numIntInfDown, numObjInfDown;
 
     double newObjValue;
 
     OsiSolverInterface * solver = model->solver();
 
-    int numCols = solver->getNumCols();
-    const double * lower = solver->getColLower();
-    const double * upper = solver->getColUpper();
-
-
     // restore bounds
     int numDiff = 0;
 
 #ifdef BLIS_DEBUG_MORE
-    for (j = 0; j < numCols; ++j) {
+    int numCols = solver->getNumCols();
+    const double * lower = solver->getColLower();
+    const double * upper = solver->getColUpper();
+    for (int j = 0; j < numCols; ++j) {
 	if (saveLower[j] != lower[j]) {
 	    //solver->setColLower(j, saveLower[j]);
             ++numDiff;
@@ -148,13 +192,17 @@ int BlisStrongBranch(BlisModel *model, double objValue, int colInd, double x,
 				   newObjValue,
 				   solver->getColSolution());
 
-	    BlisSolution* ksol = new BlisSolution(solver->getNumCols(),
-						      solver->getColSolution(),
-						      newObjValue);
+	    if (model->solutionPool()->add(solver->getNumCols(),
+					   solver->getColSolution(),
+					   newObjValue)) {
+		BlisSolution* ksol =
+		    model->createSolution(solver->getColSolution(),
+					  newObjValue);
 
-	    model->broker()->addKnowledge(AlpsKnowledgeTypeSolution,
-						      ksol,
-						      newObjValue);
+		model->broker()->addKnowledge(AlpsKnowledgeTypeSolution,
+					      ksol,
+					      newObjValue);
+	    }
 
 	    downKeep = false;
 	}
@@ -180,17 +228,7 @@ int BlisStrongBranch(BlisModel *model, double objValue, int colInd, double x,
 #endif
 
     // restore bounds
-    numDiff = 0;
-    for (j = 0; j < numCols; ++j) {
-	if (saveLower[j] != lower[j]) {
-	    solver->setColLower(j, saveLower[j]);
-            ++numDiff;
-	}
-	if (saveUpper[j] != upper[j]) {
-	    solver->setColUpper(j, saveUpper[j]);
-            ++numDiff;
-	}
-    }
+    numDiff = model->installColBounds(saveLower, saveUpper);
 #ifdef BLIS_DEBUG
     assert(numDiff > 0);
     //std::cout << "numDiff = " << numDiff << std::endl;
@@ -222,13 +260,17 @@ int BlisStrongBranch(BlisModel *model, double objValue, int colInd, double x,
 				   newObjValue,
 				   solver->getColSolution());
 
-	    BlisSolution* ksol = new BlisSolution(solver->getNumCols(),
-						  solver->getColSolution(),
-						  newObjValue);
+	    if (model->solutionPool()->add(solver->getNumCols(),
+					   solver->getColSolution(),
+					   newObjValue)) {
+		BlisSolution* ksol =
+		    model->createSolution(solver->getColSolution(),
+					  newObjValue);
 
-	    model->broker()->addKnowledge(AlpsKnowledgeTypeSolution,
-						      ksol,
-						      newObjValue);
+		model->broker()->addKnowledge(AlpsKnowledgeTypeSolution,
+					      ksol,
+					      newObjValue);
+	    }
 	    // FIXME: should not keep this branch.
 	    upKeep = false;
 	}
@@ -254,21 +296,111 @@ int BlisStrongBranch(BlisModel *model, double objValue, int colInd, double x,
 #endif
 
     // restore bounds
-    for (j = 0; j < numCols; ++j) {
-	if (saveLower[j] != lower[j]) {
-	    solver->setColLower(j,saveLower[j]);
-	}
-	if (saveUpper[j] != upper[j]) {
-	    solver->setColUpper(j,saveUpper[j]);
-	}
+    model->installColBounds(saveLower, saveUpper);
+
+    return status;
+}
+
+//#############################################################################
+
+// Status arrays are either sent as they are (2 bits per entry) or run
+// length encoded. A run is stored as its status in the lowest 2 bits of the
+// first byte, followed by (length - 1), 5 bits in the first byte and 7 bits
+// in each following byte. The highest bit of a byte tells if the length
+// continues in the next byte.
+#define BLIS_WS_RAW 0
+#define BLIS_WS_RLE 1
+
+// Pack n status entries.
+static void BlisEncodeStatus(AlpsEncoded *encoded,
+                             const char *status,
+                             int n)
+{
+    int i, k;
+    int rawSize = 4 * ((n + 15) >> 4);
+    char *rle = new char [n + 8];
+    int rleSize = 0;
+    for (i = 0; i < n && rleSize < rawSize; ) {
+        int st = getStatus(status, i);
+        for (k = i + 1; k < n && getStatus(status, k) == st; ++k);
+        int len = k - i - 1;
+        i = k;
+        char byte = static_cast<char>(st | ((len & 0x1f) << 2));
+        len >>= 5;
+        while (len > 0) {
+            rle[rleSize++] = static_cast<char>(byte | 0x80);
+            byte = static_cast<char>(len & 0x7f);
+            len >>= 7;
+        }
+        rle[rleSize++] = byte;
     }
 
+    int method = BLIS_WS_RAW;
+    if (rleSize < rawSize) {
+        method = BLIS_WS_RLE;
+    }
+    encoded->writeRep(method);
+    if (method == BLIS_WS_RLE) {
+        encoded->writeRep(rle, rleSize);
+    }
+    else {
+        encoded->writeRep(status, rawSize);
+    }
+
+    delete [] rle;
+}
+
+// Unpack n status entries packed by BlisEncodeStatus. The caller owns the
+// returned array.
+static char * BlisDecodeStatus(AlpsEncoded &encoded,
+                               int n)
+{
+    int i, k;
+    int method;
+    int size = 0;
+    char *packed = NULL;
+    int rawSize = 4 * ((n + 15) >> 4);
+
+    encoded.readRep(method);
+    encoded.readRep(packed, size);
+
+    char *status = NULL;
+    if (method == BLIS_WS_RLE) {
+        status = new char [rawSize];
+        CoinZeroN(status, rawSize);
+        int pos = 0;
+        for (i = 0; i < n; ) {
+            assert(pos < size);
+            unsigned char byte = static_cast<unsigned char>(packed[pos++]);
+            int st = byte & 0x3;
+            int len = (byte >> 2) & 0x1f;
+            int shift = 5;
+            while (byte & 0x80) {
+                assert(pos < size);
+                byte = static_cast<unsigned char>(packed[pos++]);
+                len |= (byte & 0x7f) << shift;
+                shift += 7;
+            }
+            for (k = 0; k <= len && i < n; ++k, ++i) {
+                setStatus(status, i,
+                          static_cast<CoinWarmStartBasis::Status>(st));
+            }
+        }
+        delete [] packed;
+    }
+    else {
+        assert(size == rawSize);
+        status = packed;
+    }
+    packed = NULL;
+
     return status;
 }
 
 //#############################################################################
 
-int BlisEncodeWarmStart(AlpsEncoded *encoded, const CoinWarmStartBasis *ws)
+int BlisEncodeWarmStart(AlpsEncoded *encoded,
+                        const CoinWarmStartBasis *ws)
 {
 
     int status = BLIS_OK;
@@ -279,12 +411,10 @@ int BlisEncodeWarmStart(AlpsEncoded *encoded, const CoinWarmStartBasis *ws)
     encoded->writeRep(numRows);
 
     // Pack structural.
-    int nint = (ws->getNumStructural() + 15) >> 4;
-    encoded->writeRep(ws->getStructuralStatus(), nint * 4);
+    BlisEncodeStatus(encoded, ws->getStructuralStatus(), numCols);
 
     // Pack artificial.
-    nint = (ws->getNumArtificial() + 15) >> 4;
-    encoded->writeRep(ws->getArtificialStatus(), nint * 4);
+    BlisEncodeStatus(encoded, ws->getArtificialStatus(), numRows);
 
     return status;
 }
@@ -300,19 +430,11 @@ CoinWarmStartBasis *BlisDecodeWarmStart(AlpsEncoded &encoded,
     encoded.readRep(numCols);
     encoded.readRep(numRows);
 
-    int tempInt;
-
     // Structural
-    int nint = (numCols + 15) >> 4;
-    char *structuralStatus = new char[4 * nint];
-    encoded.readRep(structuralStatus, tempInt);
-    assert(tempInt == nint*4);
+    char *structuralStatus = BlisDecodeStatus(encoded, numCols);
 
     // Artificial
-    nint = (numRows + 15) >> 4;
-    char *artificialStatus = new char[4 * nint];
-    encoded.readRep(artificialStatus, tempInt);
-    assert(tempInt == nint*4);
+    char *artificialStatus = BlisDecodeStatus(encoded, numRows);
 
     CoinWarmStartBasis *ws = new CoinWarmStartBasis();
     if (!ws) {
@@ -322,6 +444,10 @@ CoinWarmStartBasis *BlisDecodeWarmStart(AlpsEncoded &encoded,
     ws->assignBasisStatus(numCols, numRows,
 			  structuralStatus, artificialStatus);
 
+    if (rc) {
+        *rc = AlpsReturnStatusOk;
+    }
+
     return ws;
 
 }
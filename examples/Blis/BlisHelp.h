@@ -30,6 +30,7 @@
 
 class CoinWarmStartBasis;
 class OsiRowCut;
+class OsiSolverInterface;
 class BlisConstraint;
 class BlisModel;
 
@@ -41,14 +42,22 @@ BlisConstraint * BlisOsiCutToConstraint(const OsiRowCut *rowCut);
 /** Convert a Blis constraint to a OsiRowCut. */
 OsiRowCut * BlisConstraintToOsiCut(const BlisConstraint * con);
 
+/** Add constraints to the lp solver as one block of rows. Row data are
+    taken directly from the constraints, no OsiRowCut is created. */
+void BlisAddConstraintsToSolver(OsiSolverInterface *solver,
+                                int numCons,
+                                BlisConstraint * const *cons);
+
 /** Strong branching on a variable colInd. */
 int BlisStrongBranch(BlisModel *model, double objValue, int colInd, double x,
                      const double *saveLower, const double *saveUpper,
 		     bool &downKeep, bool &downFinished, double &downDeg,
 		     bool &upKeep, bool &upFinished, double &upDeg);
 
-/** Pack coin warm start into an encoded object. */
-int BlisEncodeWarmStart(AlpsEncoded *encoded, const CoinWarmStartBasis *ws);
+/** Pack coin warm start into an encoded object. Status arrays are run
+    length encoded when it is shorter. */
+int BlisEncodeWarmStart(AlpsEncoded *encoded,
+                        const CoinWarmStartBasis *ws);
 
 /** Unpack coin warm start from an encoded object. */
 CoinWarmStartBasis *BlisDecodeWarmStart(AlpsEncoded &encoded,
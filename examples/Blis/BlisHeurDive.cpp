@@ -0,0 +1,374 @@
+/*===========================================================================*
+ * This file is part of the Bcps Linear Solver (BLIS).                       *
+ *                                                                           *
+ * BLIS is distributed under the Eclipse Public License as part of the       *
+ * COIN-OR repository (http://www.coin-or.org).                              *
+ *                                                                           *
+ * Authors:                                                                  *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *                                                                           *
+ * Conceptual Design:                                                        *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *          Laszlo Ladanyi, IBM T.J. Watson Research Center                  *
+ *          Matthew Saltzman, Clemson University                             *
+ *                                                                           *
+ *                                                                           *
+ * Copyright (C) 2001-2017, Lehigh University, Yan Xu, and Ted Ralphs.       *
+ * All Rights Reserved.                                                      *
+ *===========================================================================*/
+
+#include <cstring>
+
+#include "CoinFinite.hpp"
+#include "CoinTime.hpp"
+#include "CoinWarmStart.hpp"
+
+#include "BlisHeurDive.h"
+#include "BlisModel.h"
+#include "BlisObjectInt.h"
+#include "BlisSolutionPool.h"
+
+//#############################################################################
+
+BlisHeurDive::BlisHeurDive(BlisModel *model, const char *name, int strategy)
+    :
+    BlisHeuristic(model, name, strategy),
+    iterations_(0)
+{
+    integerTol_ = model->BlisPar()->entry(BlisParams::integerTol);
+}
+
+//#############################################################################
+
+BlisHeurDive::BlisHeurDive(const BlisHeurDive & rhs)
+    :
+    BlisHeuristic(rhs),
+    iterations_(0),
+    integerTol_(rhs.integerTol_)
+{}
+
+//#############################################################################
+
+bool
+BlisHeurDive::searchSolution(double & solutionValue, double * betterSolution)
+{
+    bool foundBetter = false;
+
+    if (strategy_ == -2) {
+        // This heuristic has been disabled.
+        return foundBetter;
+    }
+
+    OsiSolverInterface * lp = model_->solver();
+    if (!lp->isProvenOptimal()) {
+        return foundBetter;
+    }
+
+    double ratio = model_->BlisPar()->entry(BlisParams::heurDiveIterRatio);
+    double budget = ratio * model_->getNumIterations() + 1000.0;
+    budget -= iterations_;
+    if (budget <= 0.0) {
+        return foundBetter;
+    }
+
+    //------------------------------------------------------
+    // Start to dive ...
+    //------------------------------------------------------
+
+    double start = CoinCpuTime();
+
+    OsiSolverInterface * solver = lp->clone();
+    CoinWarmStart * ws = lp->getWarmStart();
+    solver->setWarmStart(ws);
+    delete ws;
+
+    // Stop as soon as the dive can not beat the incumbent.
+    double direction = solver->getObjSense();
+    if (solutionValue < COIN_DBL_MAX) {
+        solver->setDblParam(OsiDualObjectiveLimit, direction * solutionValue);
+    }
+
+    int numCols = solver->getNumCols();
+    int numIntVars = model_->getNumIntVars();
+    const int * intVars = model_->getIntVars();
+    int used = 0;
+    int depth = 0;
+
+    while (used < budget && depth < numIntVars) {
+        const double * x = solver->getColSolution();
+
+        int i;
+        for (i = 0; i < numIntVars; ++i) {
+            if (!isIntegral(x[intVars[i]])) {
+                break;
+            }
+        }
+        if (i == numIntVars) {
+            // No fractional integer column left.
+            double value = direction * solver->getObjValue();
+            if (value < solutionValue) {
+                memcpy(betterSolution, x, numCols * sizeof(double));
+                solutionValue = value;
+                foundBetter = true;
+            }
+            break;
+        }
+
+        bool up = false;
+        int j = selectVariable(solver, x, up);
+        if (j < 0) {
+            break;
+        }
+
+        double value = x[j];
+        double lower = solver->getColLower()[j];
+        double upper = solver->getColUpper()[j];
+        if (up) {
+            solver->setColLower(j, ceil(value));
+        }
+        else {
+            solver->setColUpper(j, floor(value));
+        }
+        solver->resolve();
+        used += solver->getIterationCount();
+        ++depth;
+
+        if (!solver->isProvenOptimal()) {
+            // Round the other way once.
+            if (up) {
+                solver->setColBounds(j, lower, floor(value));
+            }
+            else {
+                solver->setColBounds(j, ceil(value), upper);
+            }
+            solver->resolve();
+            used += solver->getIterationCount();
+            if (!solver->isProvenOptimal()) {
+                break;
+            }
+        }
+    }
+
+    delete solver;
+
+    //------------------------------------------------------
+    // Update statistics.
+    //------------------------------------------------------
+
+    iterations_ += used;
+    ++calls_;
+    if (foundBetter) ++numSolutions_;
+    time_ += (CoinCpuTime() - start);
+
+    return foundBetter;
+}
+
+//#############################################################################
+
+int
+BlisHeurDiveFractional::selectVariable(OsiSolverInterface *solver,
+                                       const double *x,
+                                       bool &up)
+{
+    int numIntVars = model_->getNumIntVars();
+    const int * intVars = model_->getIntVars();
+    int best = -1;
+    double bestDist = COIN_DBL_MAX;
+
+    for (int i = 0; i < numIntVars; ++i) {
+        int j = intVars[i];
+        if (isIntegral(x[j])) {
+            continue;
+        }
+        double f = fraction(x[j]);
+        double dist = (f < 0.5) ? f : 1.0 - f;
+        if (dist < bestDist) {
+            bestDist = dist;
+            best = j;
+            up = (f >= 0.5);
+        }
+    }
+
+    return best;
+}
+
+//#############################################################################
+
+BlisHeurDiveCoefficient::BlisHeurDiveCoefficient(BlisModel *model,
+                                                 const char *name,
+                                                 int strategy)
+    :
+    BlisHeurDive(model, name, strategy)
+{
+    const CoinPackedMatrix & matrix = model->getColMatrix();
+    const double * element = matrix.getElements();
+    const int * row = matrix.getIndices();
+    const CoinBigIndex * start = matrix.getVectorStarts();
+    const int * length = matrix.getVectorLengths();
+    const double * rowLower = model->solver()->getRowLower();
+    const double * rowUpper = model->solver()->getRowUpper();
+    double infinity = model->solver()->getInfinity();
+    int numCols = matrix.getNumCols();
+
+    downLocks_.assign(numCols, 0);
+    upLocks_.assign(numCols, 0);
+
+    for (int j = 0; j < numCols; ++j) {
+        for (CoinBigIndex k = start[j]; k < start[j] + length[j]; ++k) {
+            bool hasLower = rowLower[row[k]] > -infinity;
+            bool hasUpper = rowUpper[row[k]] < infinity;
+            if (element[k] > 0.0) {
+                if (hasLower) ++downLocks_[j];
+                if (hasUpper) ++upLocks_[j];
+            }
+            else {
+                if (hasUpper) ++downLocks_[j];
+                if (hasLower) ++upLocks_[j];
+            }
+        }
+    }
+}
+
+//#############################################################################
+
+int
+BlisHeurDiveCoefficient::selectVariable(OsiSolverInterface *solver,
+                                        const double *x,
+                                        bool &up)
+{
+    int numIntVars = model_->getNumIntVars();
+    const int * intVars = model_->getIntVars();
+    int best = -1;
+    int bestLocks = 0;
+    double bestDist = COIN_DBL_MAX;
+
+    for (int i = 0; i < numIntVars; ++i) {
+        int j = intVars[i];
+        if (isIntegral(x[j])) {
+            continue;
+        }
+        double f = fraction(x[j]);
+        bool thisUp;
+        if (downLocks_[j] != upLocks_[j]) {
+            thisUp = (upLocks_[j] < downLocks_[j]);
+        }
+        else {
+            thisUp = (f >= 0.5);
+        }
+        int locks = thisUp ? upLocks_[j] : downLocks_[j];
+        double dist = thisUp ? 1.0 - f : f;
+        if (best < 0 || locks < bestLocks ||
+            (locks == bestLocks && dist < bestDist)) {
+            best = j;
+            bestLocks = locks;
+            bestDist = dist;
+            up = thisUp;
+        }
+    }
+
+    return best;
+}
+
+//#############################################################################
+
+int
+BlisHeurDivePseudocost::selectVariable(OsiSolverInterface *solver,
+                                       const double *x,
+                                       bool &up)
+{
+    int numIntVars = model_->getNumIntVars();
+    const int * intVars = model_->getIntVars();
+    int best = -1;
+    double bestScore = COIN_DBL_MAX;
+
+    for (int i = 0; i < numIntVars; ++i) {
+        int j = intVars[i];
+        if (isIntegral(x[j])) {
+            continue;
+        }
+        BlisObjectInt * intObject =
+            dynamic_cast<BlisObjectInt *>(model_->objects(i));
+        BlisPseudocost & pseudo = intObject->pseudocost();
+        double f = fraction(x[j]);
+        double downCost = pseudo.getDownCost() * f;
+        double upCost = pseudo.getUpCost() * (1.0 - f);
+        bool thisUp = (upCost < downCost) ||
+            (upCost == downCost && f >= 0.5);
+        // Small when the chosen way is much cheaper than the other.
+        double score = thisUp ? (upCost + 1.0e-6) / (downCost + 1.0e-6) :
+            (downCost + 1.0e-6) / (upCost + 1.0e-6);
+        if (score < bestScore) {
+            best = j;
+            bestScore = score;
+            up = thisUp;
+        }
+    }
+
+    return best;
+}
+
+//#############################################################################
+
+bool
+BlisHeurDiveGuided::searchSolution(double & solutionValue,
+                                   double * betterSolution)
+{
+    int numCols = model_->solver()->getNumCols();
+    BlisSolutionPool * pool = model_->solutionPool();
+
+    guide_.clear();
+    if (pool && pool->getNumSolutions() > 0) {
+        const BlisSolution * sol =
+            pool->getSolution(calls_ % pool->getNumSolutions());
+        if (sol->getSize() == numCols) {
+            guide_.resize(numCols);
+            sol->getDenseValues(&guide_[0]);
+        }
+    }
+    // No usable pool solution (none yet, or one of another size after
+    // columns changed), guide by the incumbent.
+    if (guide_.empty() && model_->incumbent()) {
+        guide_.assign(model_->incumbent(), model_->incumbent() + numCols);
+    }
+
+    if (guide_.empty()) {
+        return false;
+    }
+    return BlisHeurDive::searchSolution(solutionValue, betterSolution);
+}
+
+//#############################################################################
+
+int
+BlisHeurDiveGuided::selectVariable(OsiSolverInterface *solver,
+                                   const double *x,
+                                   bool &up)
+{
+    const double * guide = &guide_[0];
+
+    int numIntVars = model_->getNumIntVars();
+    const int * intVars = model_->getIntVars();
+    int best = -1;
+    double bestDist = COIN_DBL_MAX;
+
+    for (int i = 0; i < numIntVars; ++i) {
+        int j = intVars[i];
+        if (isIntegral(x[j])) {
+            continue;
+        }
+        double dist = fabs(x[j] - guide[j]);
+        if (dist < bestDist) {
+            best = j;
+            bestDist = dist;
+            up = (guide[j] > x[j]);
+        }
+    }
+
+    return best;
+}
+
+//#############################################################################
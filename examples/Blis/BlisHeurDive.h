@@ -0,0 +1,203 @@
+/*===========================================================================*
+ * This file is part of the Bcps Linear Solver (BLIS).                       *
+ *                                                                           *
+ * BLIS is distributed under the Eclipse Public License as part of the       *
+ * COIN-OR repository (http://www.coin-or.org).                              *
+ *                                                                           *
+ * Authors:                                                                  *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *                                                                           *
+ * Conceptual Design:                                                        *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *          Laszlo Ladanyi, IBM T.J. Watson Research Center                  *
+ *          Matthew Saltzman, Clemson University                             *
+ *                                                                           *
+ *                                                                           *
+ * Copyright (C) 2001-2017, Lehigh University, Yan Xu, and Ted Ralphs.       *
+ * All Rights Reserved.                                                      *
+ *===========================================================================*/
+
+#ifndef BlisHeurDive_h_
+#define BlisHeurDive_h_
+
+#include <cmath>
+#include <vector>
+
+#include "OsiSolverInterface.hpp"
+
+#include "BlisHeuristic.h"
+
+class BlisModel;
+
+//#############################################################################
+
+/** Diving heuristic base class.
+    A dive works on a clone of the node lp, hot started from its basis. It
+    rounds one fractional integer column by changing its bound and resolves,
+    until the lp solution is integral, the lp is infeasible or cut off, or
+    the lp iteration budget is used. If the lp becomes infeasible, the
+    column is rounded the other way once. The budget of all dives of a
+    heuristic is Blis_heurDiveIterRatio times the lp iterations of the
+    search so far, plus 1000. Derived classes choose the column and the
+    direction.
+*/
+class BlisHeurDive : public BlisHeuristic {
+
+ private:
+
+    /** Illegal Assignment operator. */
+    BlisHeurDive & operator=(const BlisHeurDive& rhs);
+
+ protected:
+
+    /** Lp iterations used by all dives of this heuristic. */
+    int iterations_;
+
+    /** Tolerance to treat as an integer. */
+    double integerTol_;
+
+    /** Choose a fractional integer column of the lp solution x, and set
+        up to round it up. The column index is returned, -1 if the dive
+        should stop. x has at least one fractional integer column. */
+    virtual int selectVariable(OsiSolverInterface *solver,
+                               const double *x,
+                               bool &up) = 0;
+
+    /** Return the fractional part of value. */
+    double fraction(double value) const { return value - floor(value); }
+
+    /** Return true if value is integral within the tolerance. */
+    bool isIntegral(double value) const {
+        double f = fraction(value);
+        return (f <= integerTol_ || f >= 1.0 - integerTol_);
+    }
+
+ public:
+
+    /** Useful constructor. */
+    BlisHeurDive(BlisModel *model, const char *name, int strategy);
+
+    /** Copy constructor. */
+    BlisHeurDive(const BlisHeurDive &);
+
+    /** Destructor. */
+    virtual ~BlisHeurDive() {}
+
+    /** Dive from the lp of the node being processed. */
+    virtual bool searchSolution(double & objectiveValue,
+                                double * newSolution);
+
+    /** Solutions are counted as diving solutions. */
+    virtual BLIS_SOL_TYPE solType() const { return BLIS_SOL_DIVING; }
+};
+
+//#############################################################################
+
+/** Round the column closest to an integer, to the nearest integer. */
+class BlisHeurDiveFractional : public BlisHeurDive {
+
+ protected:
+
+    virtual int selectVariable(OsiSolverInterface *solver,
+                               const double *x,
+                               bool &up);
+
+ public:
+
+    BlisHeurDiveFractional(BlisModel *model, const char *name, int strategy)
+        :
+        BlisHeurDive(model, name, strategy) {}
+
+    virtual BlisHeuristic * clone() const {
+        return new BlisHeurDiveFractional(*this);
+    }
+};
+
+//#############################################################################
+
+/** Round the column with the fewest locks in the rounding direction, the
+    number of core rows that moving it that way can violate. Ties go to the
+    column closest to an integer. */
+class BlisHeurDiveCoefficient : public BlisHeurDive {
+
+ protected:
+
+    /** Number of core rows that can be violated when a column moves down
+        and up. */
+    std::vector<int> downLocks_;
+    std::vector<int> upLocks_;
+
+    virtual int selectVariable(OsiSolverInterface *solver,
+                               const double *x,
+                               bool &up);
+
+ public:
+
+    BlisHeurDiveCoefficient(BlisModel *model, const char *name, int strategy);
+
+    virtual BlisHeuristic * clone() const {
+        return new BlisHeurDiveCoefficient(*this);
+    }
+};
+
+//#############################################################################
+
+/** Round each column the way its pseudocosts say is cheaper, choosing the
+    column for which this is most clear. */
+class BlisHeurDivePseudocost : public BlisHeurDive {
+
+ protected:
+
+    virtual int selectVariable(OsiSolverInterface *solver,
+                               const double *x,
+                               bool &up);
+
+ public:
+
+    BlisHeurDivePseudocost(BlisModel *model, const char *name, int strategy)
+        :
+        BlisHeurDive(model, name, strategy) {}
+
+    virtual BlisHeuristic * clone() const {
+        return new BlisHeurDivePseudocost(*this);
+    }
+};
+
+//#############################################################################
+
+/** Round columns toward their value in a guide solution, the column
+    closest to it first. Successive dives take their guide in turn from the
+    best solutions of the solution pool, or the incumbent if the pool is
+    empty or its solution does not match the columns. Does not dive without
+    a guide. */
+class BlisHeurDiveGuided : public BlisHeurDive {
+
+ protected:
+
+    /** Guide solution of the current dive, empty if none. */
+    std::vector<double> guide_;
+
+    virtual int selectVariable(OsiSolverInterface *solver,
+                               const double *x,
+                               bool &up);
+
+ public:
+
+    BlisHeurDiveGuided(BlisModel *model, const char *name, int strategy)
+        :
+        BlisHeurDive(model, name, strategy) {}
+
+    virtual BlisHeuristic * clone() const {
+        return new BlisHeurDiveGuided(*this);
+    }
+
+    /** Pick the guide solution, then dive. */
+    virtual bool searchSolution(double & objectiveValue,
+                                double * newSolution);
+};
+
+#endif
@@ -0,0 +1,249 @@
+/*===========================================================================*
+ * This file is part of the Bcps Linear Solver (BLIS).                       *
+ *                                                                           *
+ * BLIS is distributed under the Eclipse Public License as part of the       *
+ * COIN-OR repository (http://www.coin-or.org).                              *
+ *                                                                           *
+ * Authors:                                                                  *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *                                                                           *
+ * Conceptual Design:                                                        *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *          Laszlo Ladanyi, IBM T.J. Watson Research Center                  *
+ *          Matthew Saltzman, Clemson University                             *
+ *                                                                           *
+ *                                                                           *
+ * Copyright (C) 2001-2017, Lehigh University, Yan Xu, and Ted Ralphs.       *
+ * All Rights Reserved.                                                      *
+ *===========================================================================*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <deque>
+
+#include "CoinFinite.hpp"
+#include "CoinTime.hpp"
+#include "CoinWarmStart.hpp"
+
+#include "BlisHeurFPump.h"
+#include "BlisModel.h"
+
+/** Number of old roundings checked for cycles. */
+#define BLIS_FPUMP_HISTORY 3
+
+//#############################################################################
+
+BlisHeurFPump::BlisHeurFPump(BlisModel *model, const char *name, int strategy)
+    :
+    BlisHeuristic(model, name, strategy),
+    random_(1)
+{
+    integerTol_ = model->BlisPar()->entry(BlisParams::integerTol);
+}
+
+//#############################################################################
+
+BlisHeurFPump::BlisHeurFPump(const BlisHeurFPump & rhs)
+    :
+    BlisHeuristic(rhs),
+    integerTol_(rhs.integerTol_),
+    random_(rhs.random_)
+{}
+
+//#############################################################################
+
+void
+BlisHeurFPump::roundSolution(const double *x,
+                             std::vector<double> &rounded) const
+{
+    int numIntVars = model_->getNumIntVars();
+    const int * intVars = model_->getIntVars();
+
+    rounded.resize(numIntVars);
+    for (int i = 0; i < numIntVars; ++i) {
+        rounded[i] = floor(x[intVars[i]] + 0.5);
+    }
+}
+
+//#############################################################################
+
+bool
+BlisHeurFPump::isIntegral(const double *x) const
+{
+    int numIntVars = model_->getNumIntVars();
+    const int * intVars = model_->getIntVars();
+
+    for (int i = 0; i < numIntVars; ++i) {
+        double value = x[intVars[i]];
+        if (fabs(value - floor(value + 0.5)) > integerTol_) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//#############################################################################
+
+bool
+BlisHeurFPump::searchSolution(double & solutionValue, double * betterSolution)
+{
+    bool foundBetter = false;
+
+    if (strategy_ == -2 || calls_ > 0 || model_->incumbent()) {
+        // Disabled, already pumped or not needed.
+        return foundBetter;
+    }
+
+    OsiSolverInterface * lp = model_->solver();
+    if (!lp->isProvenOptimal()) {
+        return foundBetter;
+    }
+
+    double start = CoinCpuTime();
+    double timeLimit = model_->BlisPar()->entry(BlisParams::heurFPumpTime);
+
+    //------------------------------------------------------
+    // Set up the lp clone.
+    //------------------------------------------------------
+
+    OsiSolverInterface * solver = lp->clone();
+    CoinWarmStart * ws = lp->getWarmStart();
+    solver->setWarmStart(ws);
+    delete ws;
+
+    // The distance objective has nothing to do with the cutoff.
+    double direction = solver->getObjSense();
+    solver->setDblParam(OsiDualObjectiveLimit, direction * COIN_DBL_MAX);
+
+    int numCols = solver->getNumCols();
+    int numIntVars = model_->getNumIntVars();
+    const int * intVars = model_->getIntVars();
+    std::vector<double> lower(solver->getColLower(),
+                              solver->getColLower() + numCols);
+    std::vector<double> upper(solver->getColUpper(),
+                              solver->getColUpper() + numCols);
+    std::vector<double> objective(solver->getObjCoefficients(),
+                                  solver->getObjCoefficients() + numCols);
+    std::vector<double> distance(numCols, 0.0);
+    std::vector<double> rounded;
+    std::vector<double> previous;
+    std::deque<std::vector<double> > history;
+    std::vector<std::pair<double, int> > score;
+
+    const double * x = solver->getColSolution();
+    roundSolution(x, rounded);
+
+    //------------------------------------------------------
+    // Pump.
+    //------------------------------------------------------
+
+    bool integral = isIntegral(x);
+
+    while (!integral && CoinCpuTime() - start < timeLimit) {
+        // Minimize the L1 distance to the rounding.
+        for (int i = 0; i < numIntVars; ++i) {
+            int j = intVars[i];
+            if (rounded[i] <= lower[j] + integerTol_) {
+                distance[j] = direction;
+            }
+            else if (rounded[i] >= upper[j] - integerTol_) {
+                distance[j] = -direction;
+            }
+            else {
+                distance[j] = 0.0;
+            }
+        }
+        solver->setObjective(&distance[0]);
+        solver->resolve();
+        if (!solver->isProvenOptimal()) {
+            break;
+        }
+
+        x = solver->getColSolution();
+        integral = isIntegral(x);
+        if (integral) {
+            break;
+        }
+
+        previous.swap(rounded);
+        roundSolution(x, rounded);
+
+        if (rounded == previous) {
+            // Short cycle: flip the columns farthest from the rounding.
+            score.clear();
+            for (int i = 0; i < numIntVars; ++i) {
+                double dist = fabs(x[intVars[i]] - rounded[i]);
+                if (dist > integerTol_) {
+                    score.push_back(std::make_pair(-dist, i));
+                }
+            }
+            std::sort(score.begin(), score.end());
+            int numFlips = 10 + static_cast<int>(20 * random_.randomDouble());
+            for (int k = 0; k < numFlips && k < (int)score.size(); ++k) {
+                int i = score[k].second;
+                int j = intVars[i];
+                rounded[i] += (x[j] > rounded[i]) ? 1.0 : -1.0;
+                rounded[i] = CoinMax(lower[j], CoinMin(upper[j], rounded[i]));
+            }
+        }
+        else if (std::find(history.begin(), history.end(), rounded) !=
+                 history.end()) {
+            // Long cycle: perturb at random.
+            for (int i = 0; i < numIntVars; ++i) {
+                int j = intVars[i];
+                double noise = CoinMax(random_.randomDouble() - 0.3, 0.0);
+                if (fabs(x[j] - rounded[i]) + noise > 0.5) {
+                    rounded[i] += (x[j] > rounded[i]) ? 1.0 : -1.0;
+                    rounded[i] = CoinMax(lower[j],
+                                         CoinMin(upper[j], rounded[i]));
+                }
+            }
+        }
+
+        history.push_back(previous);
+        if (history.size() > BLIS_FPUMP_HISTORY) {
+            history.pop_front();
+        }
+    }
+
+    //------------------------------------------------------
+    // Polish an integral point with the original objective.
+    //------------------------------------------------------
+
+    if (integral) {
+        roundSolution(solver->getColSolution(), rounded);
+        for (int i = 0; i < numIntVars; ++i) {
+            solver->setColBounds(intVars[i], rounded[i], rounded[i]);
+        }
+        solver->setObjective(&objective[0]);
+        solver->resolve();
+        if (solver->isProvenOptimal()) {
+            double value = direction * solver->getObjValue();
+            if (value < solutionValue) {
+                memcpy(betterSolution, solver->getColSolution(),
+                       numCols * sizeof(double));
+                solutionValue = value;
+                foundBetter = true;
+            }
+        }
+    }
+
+    delete solver;
+
+    //------------------------------------------------------
+    // Update statistics.
+    //------------------------------------------------------
+
+    ++calls_;
+    if (foundBetter) ++numSolutions_;
+    time_ += (CoinCpuTime() - start);
+
+    return foundBetter;
+}
+
+//#############################################################################
@@ -0,0 +1,94 @@
+/*===========================================================================*
+ * This file is part of the Bcps Linear Solver (BLIS).                       *
+ *                                                                           *
+ * BLIS is distributed under the Eclipse Public License as part of the       *
+ * COIN-OR repository (http://www.coin-or.org).                              *
+ *                                                                           *
+ * Authors:                                                                  *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *                                                                           *
+ * Conceptual Design:                                                        *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *          Laszlo Ladanyi, IBM T.J. Watson Research Center                  *
+ *          Matthew Saltzman, Clemson University                             *
+ *                                                                           *
+ *                                                                           *
+ * Copyright (C) 2001-2017, Lehigh University, Yan Xu, and Ted Ralphs.       *
+ * All Rights Reserved.                                                      *
+ *===========================================================================*/
+
+#ifndef BlisHeurFPump_h_
+#define BlisHeurFPump_h_
+
+#include <vector>
+
+#include "CoinHelperFunctions.hpp"
+#include "OsiSolverInterface.hpp"
+
+#include "BlisHeuristic.h"
+
+class BlisModel;
+
+//#############################################################################
+
+/** Feasibility pump heuristic.
+    Works on a clone of the root lp. Each pass rounds the integer columns of
+    the lp solution and solves the lp again with an objective that is the
+    L1 distance to the rounding, until the lp solution is integral. A
+    rounding that repeats the last one gets its most fractional columns
+    flipped; a rounding that repeats an older one is randomly perturbed.
+    General integer columns strictly between their bounds in the rounding
+    do not count in the distance. An integral point is polished by fixing
+    the integer columns and solving with the original objective.
+
+    The pump is meant to find a first solution, so it runs at most once
+    and only while there is no incumbent. It stops after
+    Blis_heurFPumpTime cpu seconds.
+*/
+class BlisHeurFPump : public BlisHeuristic {
+
+ private:
+
+    /** Illegal Assignment operator. */
+    BlisHeurFPump & operator=(const BlisHeurFPump& rhs);
+
+ protected:
+
+    /** Tolerance to treat as an integer. */
+    double integerTol_;
+
+    /** Random numbers for the perturbation. */
+    CoinThreadRandom random_;
+
+    /** Round the integer columns of x into rounded. */
+    void roundSolution(const double *x, std::vector<double> &rounded) const;
+
+    /** Return true if the integer columns of x are integral. */
+    bool isIntegral(const double *x) const;
+
+ public:
+
+    /** Useful constructor. */
+    BlisHeurFPump(BlisModel *model, const char *name, int strategy);
+
+    /** Copy constructor. */
+    BlisHeurFPump(const BlisHeurFPump &);
+
+    /** Destructor. */
+    virtual ~BlisHeurFPump() {}
+
+    /** Clone a feasibility pump. */
+    virtual BlisHeuristic * clone() const {
+        return new BlisHeurFPump(*this);
+    }
+
+    /** Pump from the lp of the node being processed. */
+    virtual bool searchSolution(double & objectiveValue,
+                                double * newSolution);
+};
+
+#endif
@@ -37,7 +37,15 @@ BlisHeurRound::BlisHeurRound(const BlisHeurRound & rhs)
     BlisHeuristic(rhs),
     matrix_(rhs.matrix_),
     matrixByRow_(rhs.matrixByRow_),
-    seed_(rhs.seed_)
+    rowLower_(rhs.rowLower_),
+    rowUpper_(rhs.rowUpper_),
+    objective_(rhs.objective_),
+    integer_(rhs.integer_),
+    direction_(rhs.direction_),
+    primalTolerance_(rhs.primalTolerance_),
+    seed_(rhs.seed_),
+    random_(rhs.random_),
+    numIncremental_(0)
 {}
 
 
@@ -56,19 +64,33 @@ BlisHeurRound::clone() const
 void BlisHeurRound::setModel(BlisModel * model)
 {
     model_ = model;
-    // Get a copy of original matrix (and by row for rounding);
-    assert(model_->solver());
-    matrix_ = *model_->solver()->getMatrixByCol();
-    matrixByRow_ = *model_->solver()->getMatrixByRow();
+    // Core matrix (and by row for rounding) is shared with the model.
+    OsiSolverInterface * solver = model_->solver();
+    assert(solver);
+    matrix_ = &model_->getColMatrix();
+    matrixByRow_ = &model_->getRowMatrix();
+
+    int numRows = solver->getNumRows();
+    int numCols = solver->getNumCols();
+    rowLower_.assign(solver->getRowLower(), solver->getRowLower() + numRows);
+    rowUpper_.assign(solver->getRowUpper(), solver->getRowUpper() + numRows);
+    objective_.assign(solver->getObjCoefficients(),
+                      solver->getObjCoefficients() + numCols);
+    integer_.resize(numCols);
+    for (int j = 0; j < numCols; ++j) {
+        integer_[j] = solver->isInteger(j) ? 1 : 0;
+    }
+    direction_ = solver->getObjSense();
+    solver->getDblParam(OsiPrimalTolerance, primalTolerance_);
 }
 
 //#############################################################################
 
 // See if rounding will give solution
 // Sets value of solution
-// Assumes rhs for original matrix still okay
+// Only the core rows are used: cuts are valid inequalities, so a rounded
+// solution feasible for the core rows is feasible.
 // At present only works with integers
-// Fix values if asked for
 // Returns 1 if solution, 0 if not
 
 bool
@@ -87,60 +109,98 @@ BlisHeurRound::searchSolution(double & solutionValue, double * betterSolution)
 
     double start = CoinCpuTime();
 
-    // Get a copy of original matrix (and by row for rounding);
-    matrix_ = *(model_->solver()->getMatrixByCol());
-    matrixByRow_ = *(model_->solver()->getMatrixByRow());
-    seed_ = 1;
-
     OsiSolverInterface * solver = model_->solver();
-    const double * lower = solver->getColLower();
-    const double * upper = solver->getColUpper();
-    const double * rowLower = solver->getRowLower();
-    const double * rowUpper = solver->getRowUpper();
-    const double * solution = solver->getColSolution();
-    const double * objective = solver->getObjCoefficients();
+    foundBetter = roundSolution(solver->getColLower(),
+                                solver->getColUpper(),
+                                solver->getColSolution(),
+                                direction_ * solver->getObjValue(),
+                                solutionValue,
+                                betterSolution);
+
+    //------------------------------------------------------
+    // Update statistics.
+    //------------------------------------------------------
+
+    ++calls_;
+    if (foundBetter) ++numSolutions_;
+    time_ += (CoinCpuTime() - start);
+
+    return foundBetter;
+}
+
+//#############################################################################
+
+bool
+BlisHeurRound::searchSnapshot(const double * lower,
+                              const double * upper,
+                              const double * lpSolution,
+                              double lpValue,
+                              double & solutionValue,
+                              double * betterSolution)
+{
+    if (strategy_ == -2) {
+        return false;
+    }
+
+    double start = CoinCpuTime();
+
+    bool foundBetter = roundSolution(lower, upper, lpSolution, lpValue,
+                                     solutionValue, betterSolution);
+
+    ++calls_;
+    if (foundBetter) ++numSolutions_;
+    time_ += (CoinCpuTime() - start);
+
+    return foundBetter;
+}
+
+//#############################################################################
+
+bool
+BlisHeurRound::roundSolution(const double * lower,
+                             const double * upper,
+                             const double * solution,
+                             double lpValue,
+                             double & solutionValue,
+                             double * betterSolution)
+{
+    bool foundBetter = false;
+
+    const double * rowLower = &rowLower_[0];
+    const double * rowUpper = &rowUpper_[0];
+    const double * objective = &objective_[0];
     double integerTolerance = 1.0e-5;
     //model_->getDblParam(BlisModel::BlisIntegerTolerance);
-    double primalTolerance;
-    solver->getDblParam(OsiPrimalTolerance, primalTolerance);
+    double primalTolerance = primalTolerance_;
 
-    int numberRows = matrix_.getNumRows();
+    int numberRows = matrix_->getNumRows();
 
     int numberIntegers = model_->getNumIntVars();
     const int * integerVariable = model_->getIntVars();
     int i;
-    double direction = solver->getObjSense();
-    double newSolutionValue = direction * solver->getObjValue();
+    double direction = direction_;
+    double newSolutionValue = lpValue;
 
     // Column copy
-    const double * element = matrix_.getElements();
-    const int * row = matrix_.getIndices();
-    const int * columnStart = matrix_.getVectorStarts();
-    const int * columnLength = matrix_.getVectorLengths();
+    const double * element = matrix_->getElements();
+    const int * row = matrix_->getIndices();
+    const int * columnStart = matrix_->getVectorStarts();
+    const int * columnLength = matrix_->getVectorLengths();
     // Row copy
-    const double * elementByRow = matrixByRow_.getElements();
-    const int * column = matrixByRow_.getIndices();
-    const int * rowStart = matrixByRow_.getVectorStarts();
-    const int * rowLength = matrixByRow_.getVectorLengths();
+    const double * elementByRow = matrixByRow_->getElements();
+    const int * column = matrixByRow_->getIndices();
+    const int * rowStart = matrixByRow_->getVectorStarts();
+    const int * rowLength = matrixByRow_->getVectorLengths();
 
     // Get solution array for heuristic solution
-    int numberColumns = solver->getNumCols();
-    double * newSolution = new double [numberColumns];
-    memcpy(newSolution, solution, numberColumns * sizeof(double));
-
-    double * rowActivity = new double[numberRows];
-    memset(rowActivity, 0, numberRows*sizeof(double));
-    for (i = 0; i < numberColumns; i++) {
-	int j;
-	double value = newSolution[i];
-	if (value) {
-	    for (j = columnStart[i];
-		 j < columnStart[i] + columnLength[i]; j++) {
-		int iRow = row[j];
-		rowActivity[iRow] += value*element[j];
-	    }
-	}
-    }
+    int numberColumns = matrix_->getNumCols();
+    newSolution_.assign(solution, solution + numberColumns);
+    double * newSolution = &newSolution_[0];
+
+    // Row activities of the lp solution, from those of the last call.
+    updateActivity(solution);
+    rowActivity_.assign(lastActivity_.begin(), lastActivity_.end());
+    double * rowActivity = &rowActivity_[0];
     // check was feasible - if not adjust (cleaning may move)
     for (i = 0; i < numberRows; i++) {
 	if(rowActivity[i] < rowLower[i]) {
@@ -220,7 +280,7 @@ BlisHeurRound::searchSolution(double & solutionValue, double * betterSolution)
 			    double distance = absInfeasibility / absElement;
 			    double thisCost =
 				-direction * objective[iColumn] * distance;
-			    if (solver->isInteger(iColumn)) {
+			    if (integer_[iColumn]) {
 				distance = ceil(distance - primalTolerance);
 				assert (currentValue - distance >=
 					lowerValue - primalTolerance);
@@ -247,7 +307,7 @@ BlisHeurRound::searchSolution(double & solutionValue, double * betterSolution)
 			    double distance = absInfeasibility / absElement;
 			    double thisCost =
 				direction * objective[iColumn] * distance;
-			    if (solver->isInteger(iColumn)) {
+			    if (integer_[iColumn]) {
 				distance = ceil(distance - 1.0e-7);
 				assert (currentValue - distance <=
 					upperValue + primalTolerance);
@@ -288,7 +348,7 @@ BlisHeurRound::searchSolution(double & solutionValue, double * betterSolution)
 	//CoinSeedRandom(seed_);
 	// Random number between 0 and 1.
 
-	double randomNumber = CoinDrand48();
+	double randomNumber = random_.randomDouble();
 	int iPass;
 	int start[2];
 	int end[2];
@@ -389,18 +449,55 @@ BlisHeurRound::searchSolution(double & solutionValue, double * betterSolution)
 	    }
 	}
     }
-    delete [] newSolution;
-    delete [] rowActivity;
+    return foundBetter;
+}
 
-    //------------------------------------------------------
-    // Update statistics.
-    //------------------------------------------------------
+//#############################################################################
 
-    ++calls_;
-    if (foundBetter) ++numSolutions_;
-    time_ += (CoinCpuTime() - start);
+/** Only the columns whose value changed since the last call are walked.
+    A full pass is done on the first call and every 1000 calls, to keep
+    round-off from building up. */
+void
+BlisHeurRound::updateActivity(const double * solution)
+{
+    int i;
+    CoinBigIndex j;
+
+    const double * element = matrix_->getElements();
+    const int * row = matrix_->getIndices();
+    const CoinBigIndex * columnStart = matrix_->getVectorStarts();
+    const int * columnLength = matrix_->getVectorLengths();
+    int numberColumns = matrix_->getNumCols();
+    int numberRows = matrix_->getNumRows();
+
+    if (static_cast<int>(lastSolution_.size()) != numberColumns ||
+        numIncremental_ >= 1000) {
+        lastSolution_.assign(solution, solution + numberColumns);
+        lastActivity_.assign(numberRows, 0.0);
+        for (i = 0; i < numberColumns; ++i) {
+            double value = solution[i];
+            if (value) {
+                for (j = columnStart[i];
+                     j < columnStart[i] + columnLength[i]; ++j) {
+                    lastActivity_[row[j]] += value * element[j];
+                }
+            }
+        }
+        numIncremental_ = 0;
+        return;
+    }
 
-    return foundBetter;
+    for (i = 0; i < numberColumns; ++i) {
+        double delta = solution[i] - lastSolution_[i];
+        if (delta) {
+            for (j = columnStart[i];
+                 j < columnStart[i] + columnLength[i]; ++j) {
+                lastActivity_[row[j]] += delta * element[j];
+            }
+            lastSolution_[i] = solution[i];
+        }
+    }
+    ++numIncremental_;
 }
 
 //#############################################################################
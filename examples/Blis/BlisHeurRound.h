@@ -31,6 +31,7 @@
 #include <string>
 #include <vector>
 
+#include "CoinHelperFunctions.hpp"
 #include "CoinPackedMatrix.hpp"
 #include "OsiCuts.hpp"
 
@@ -47,25 +48,80 @@ class BlisHeurRound : public BlisHeuristic {
     BlisHeurRound & operator=(const BlisHeurRound& rhs);
 
  protected:
-    /** Column majored matrix. */
-    CoinPackedMatrix matrix_;
+    /** Column majored core matrix, owned by the model. */
+    const CoinPackedMatrix *matrix_;
 
-    /** Row majored matrix. */
-    CoinPackedMatrix matrixByRow_;
+    /** Row majored core matrix, owned by the model. */
+    const CoinPackedMatrix *matrixByRow_;
+
+    /** Bounds of the core rows. */
+    std::vector<double> rowLower_;
+    std::vector<double> rowUpper_;
+
+    /** Objective coefficients. */
+    std::vector<double> objective_;
+
+    /** 1 if the column is integer. */
+    std::vector<char> integer_;
+
+    /** Objective sense. */
+    double direction_;
+
+    /** Primal feasibility tolerance. */
+    double primalTolerance_;
 
     /** Seed for random stuff. */
     int seed_;
 
+    /** Random numbers, private so that a clone can run in another
+        thread. */
+    CoinThreadRandom random_;
+
+    /** Lp solution of the last call and its core row activities. */
+    std::vector<double> lastSolution_;
+    std::vector<double> lastActivity_;
+
+    /** Number of incremental activity updates since the last full pass. */
+    int numIncremental_;
+
+    /** Work arrays for the rounded solution and its row activities,
+        kept between calls. */
+    std::vector<double> newSolution_;
+    std::vector<double> rowActivity_;
+
+    /** Update lastActivity_ to the row activities of solution. */
+    void updateActivity(const double * solution);
+
+    /** Round the given lp solution of value lpValue using the core rows
+        only. The lp solver is not used. */
+    bool roundSolution(const double * lower,
+                       const double * upper,
+                       const double * solution,
+                       double lpValue,
+                       double & solutionValue,
+                       double * betterSolution);
+
  public:
     /** Default Constructor. */
-    BlisHeurRound() {}
+    BlisHeurRound()
+        :
+        matrix_(NULL),
+        matrixByRow_(NULL),
+        direction_(1.0),
+        primalTolerance_(1.0e-7),
+        seed_(1),
+        numIncremental_(0)
+        {}
 
     /** Constructor with model - assumed before cuts. */
     BlisHeurRound(BlisModel * model, const char *name, int strategy)
         :
-        BlisHeuristic(model, name, strategy)
+        BlisHeuristic(model, name, strategy),
+        seed_(1),
+        random_(1),
+        numIncremental_(0)
         {
-            assert(model->solver());
+            setModel(model);
         }
 
     /** Destructor. */
@@ -88,8 +144,22 @@ class BlisHeurRound : public BlisHeuristic {
     virtual bool searchSolution(double & objectiveValue,
                                double * newSolution);
 
+    /** Search from a node lp snapshot, see BlisHeuristic. */
+    virtual bool searchSnapshot(const double * lower,
+                                const double * upper,
+                                const double * lpSolution,
+                                double lpValue,
+                                double & objectiveValue,
+                                double * newSolution);
+
+    /** Rounding can search snapshots. */
+    virtual bool hasSnapshotSearch() const { return true; }
+
     /** Set seed */
-    void setSeed(int value) { seed_ = value; }
+    void setSeed(int value) {
+        seed_ = value;
+        random_.setSeed(value);
+    }
 
 };
 #endif
@@ -0,0 +1,306 @@
+/*===========================================================================*
+ * This file is part of the Bcps Linear Solver (BLIS).                       *
+ *                                                                           *
+ * BLIS is distributed under the Eclipse Public License as part of the       *
+ * COIN-OR repository (http://www.coin-or.org).                              *
+ *                                                                           *
+ * Authors:                                                                  *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *                                                                           *
+ * Conceptual Design:                                                        *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *          Laszlo Ladanyi, IBM T.J. Watson Research Center                  *
+ *          Matthew Saltzman, Clemson University                             *
+ *                                                                           *
+ *                                                                           *
+ * Copyright (C) 2001-2017, Lehigh University, Yan Xu, and Ted Ralphs.       *
+ * All Rights Reserved.                                                      *
+ *===========================================================================*/
+
+#include "BlisConfig.h"
+
+#include <algorithm>
+#include <iostream>
+
+#ifdef HAVE_PTHREAD_H
+#define BLIS_HAS_THREADS
+#include <pthread.h>
+#endif
+
+#include "CoinFinite.hpp"
+
+#include "BlisHeuristic.h"
+#include "BlisHeurWorker.h"
+#include "BlisModel.h"
+
+//#############################################################################
+
+#ifdef BLIS_HAS_THREADS
+struct BlisHeurWorker::Sync {
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+};
+#else
+/** Without threads the worker never starts, there is nothing to
+    synchronize. */
+struct BlisHeurWorker::Sync {};
+#endif
+
+//#############################################################################
+
+BlisHeurWorker::BlisHeurWorker(BlisModel *model, int maxQueue)
+    :
+    numCols_(model->solver()->getNumCols()),
+    maxQueue_(std::max(1, maxQueue)),
+    incumbent_(COIN_DBL_MAX),
+    numDropped_(0),
+    stop_(false),
+    running_(false),
+    sync_(new Sync)
+{
+    for (int k = 0; k < model->numHeuristics(); ++k) {
+        BlisHeuristic *heur = model->heuristics(k);
+        if (heur->strategy() != -2 && heur->hasSnapshotSearch()) {
+            heuristics_.push_back(heur->clone());
+        }
+    }
+
+#ifdef BLIS_HAS_THREADS
+    pthread_mutex_init(&sync_->mutex, NULL);
+    pthread_cond_init(&sync_->cond, NULL);
+#endif
+}
+
+//#############################################################################
+
+BlisHeurWorker::~BlisHeurWorker()
+{
+#ifdef BLIS_HAS_THREADS
+    if (running_) {
+        lock();
+        stop_ = true;
+        wake();
+        unlock();
+        pthread_join(sync_->thread, NULL);
+    }
+
+    pthread_cond_destroy(&sync_->cond);
+    pthread_mutex_destroy(&sync_->mutex);
+#endif
+    delete sync_;
+
+    size_t k;
+    for (k = 0; k < heuristics_.size(); ++k) {
+        delete heuristics_[k];
+    }
+    for (k = 0; k < queue_.size(); ++k) {
+        delete queue_[k];
+    }
+    for (k = 0; k < found_.size(); ++k) {
+        delete found_[k];
+    }
+    for (k = 0; k < free_.size(); ++k) {
+        delete free_[k];
+    }
+}
+
+//#############################################################################
+
+bool
+BlisHeurWorker::start()
+{
+    if (running_ || heuristics_.empty()) {
+        return running_;
+    }
+#ifdef BLIS_HAS_THREADS
+    if (pthread_create(&sync_->thread, NULL, &BlisHeurWorker::run,
+                       this) != 0) {
+        std::cerr << "BLIS: can not start the heuristic thread" << std::endl;
+        return false;
+    }
+    running_ = true;
+    return true;
+#else
+    std::cerr << "BLIS: threads are not available, heuristics run at the "
+              << "nodes" << std::endl;
+    return false;
+#endif
+}
+
+//#############################################################################
+
+void
+BlisHeurWorker::lock()
+{
+#ifdef BLIS_HAS_THREADS
+    pthread_mutex_lock(&sync_->mutex);
+#endif
+}
+
+//#############################################################################
+
+void
+BlisHeurWorker::unlock()
+{
+#ifdef BLIS_HAS_THREADS
+    pthread_mutex_unlock(&sync_->mutex);
+#endif
+}
+
+//#############################################################################
+
+void
+BlisHeurWorker::wake()
+{
+#ifdef BLIS_HAS_THREADS
+    pthread_cond_signal(&sync_->cond);
+#endif
+}
+
+//#############################################################################
+
+void *
+BlisHeurWorker::run(void *arg)
+{
+    static_cast<BlisHeurWorker *>(arg)->loop();
+    return NULL;
+}
+
+//#############################################################################
+
+BlisHeurSnapshot *
+BlisHeurWorker::getSnapshot()
+{
+    if (free_.empty()) {
+        return new BlisHeurSnapshot;
+    }
+    BlisHeurSnapshot *snap = free_.back();
+    free_.pop_back();
+    return snap;
+}
+
+//#############################################################################
+
+void
+BlisHeurWorker::post(const double *lower,
+                     const double *upper,
+                     const double *lpSolution,
+                     double lpValue,
+                     double incumbent)
+{
+    lock();
+
+    if (incumbent < incumbent_) {
+        incumbent_ = incumbent;
+    }
+
+    if (static_cast<int>(queue_.size()) >= maxQueue_) {
+        // Drop the oldest, the search has moved on from it.
+        free_.push_back(queue_.front());
+        queue_.pop_front();
+        ++numDropped_;
+    }
+
+    BlisHeurSnapshot *snap = getSnapshot();
+    snap->value = lpValue;
+    snap->lower.assign(lower, lower + numCols_);
+    snap->upper.assign(upper, upper + numCols_);
+    snap->x.assign(lpSolution, lpSolution + numCols_);
+    queue_.push_back(snap);
+
+    wake();
+    unlock();
+}
+
+//#############################################################################
+
+bool
+BlisHeurWorker::collect(double &value, double *x)
+{
+    bool found = false;
+
+    lock();
+    if (!found_.empty()) {
+        BlisHeurSnapshot *sol = found_.front();
+        found_.pop_front();
+        value = sol->value;
+        std::copy(sol->x.begin(), sol->x.end(), x);
+        free_.push_back(sol);
+        found = true;
+    }
+    unlock();
+
+    return found;
+}
+
+//#############################################################################
+
+void
+BlisHeurWorker::loop()
+{
+    std::vector<double> solution(numCols_);
+    std::vector<double> best(numCols_);
+
+    lock();
+
+    while (true) {
+#ifdef BLIS_HAS_THREADS
+        while (!stop_ && queue_.empty()) {
+            pthread_cond_wait(&sync_->cond, &sync_->mutex);
+        }
+#endif
+        if (stop_ || queue_.empty()) {
+            break;
+        }
+
+        BlisHeurSnapshot *snap = queue_.front();
+        queue_.pop_front();
+        double bestValue = incumbent_;
+
+        unlock();
+
+        //------------------------------------------------------
+        // Search without holding the lock. Nodes whose lp can not
+        // improve the incumbent are skipped.
+        //------------------------------------------------------
+
+        bool found = false;
+        if (snap->value < bestValue) {
+            for (size_t k = 0; k < heuristics_.size(); ++k) {
+                double value = bestValue;
+                if (heuristics_[k]->searchSnapshot(&snap->lower[0],
+                                                   &snap->upper[0],
+                                                   &snap->x[0],
+                                                   snap->value,
+                                                   value,
+                                                   &solution[0]) &&
+                    value < bestValue) {
+                    bestValue = value;
+                    found = true;
+                    best.swap(solution);
+                }
+            }
+        }
+
+        lock();
+
+        if (found && bestValue < incumbent_) {
+            incumbent_ = bestValue;
+            snap->value = bestValue;
+            snap->x.swap(best);
+            found_.push_back(snap);
+        }
+        else {
+            free_.push_back(snap);
+        }
+    }
+
+    unlock();
+}
+
+//#############################################################################
@@ -0,0 +1,142 @@
+/*===========================================================================*
+ * This file is part of the Bcps Linear Solver (BLIS).                       *
+ *                                                                           *
+ * BLIS is distributed under the Eclipse Public License as part of the       *
+ * COIN-OR repository (http://www.coin-or.org).                              *
+ *                                                                           *
+ * Authors:                                                                  *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *                                                                           *
+ * Conceptual Design:                                                        *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *          Laszlo Ladanyi, IBM T.J. Watson Research Center                  *
+ *          Matthew Saltzman, Clemson University                             *
+ *                                                                           *
+ *                                                                           *
+ * Copyright (C) 2001-2017, Lehigh University, Yan Xu, and Ted Ralphs.       *
+ * All Rights Reserved.                                                      *
+ *===========================================================================*/
+
+#ifndef BlisHeurWorker_h_
+#define BlisHeurWorker_h_
+
+#include <deque>
+#include <vector>
+
+class BlisHeuristic;
+class BlisModel;
+
+//#############################################################################
+
+/** Node lp data handed to the heuristic thread, also used to hand back
+    a solution found (value and x only). */
+struct BlisHeurSnapshot {
+    /** Lp objective value, or solution value, in minimization form. */
+    double value;
+    /** Column bounds at the node. */
+    std::vector<double> lower;
+    std::vector<double> upper;
+    /** Lp solution, or solution found. */
+    std::vector<double> x;
+};
+
+//#############################################################################
+
+/** Runs primal heuristics in a background thread.
+    The node loop posts snapshots of optimal node lps into a bounded queue;
+    when the queue is full the oldest snapshot is dropped. The thread runs
+    clones of the model heuristics on the snapshots through
+    BlisHeuristic::searchSnapshot, which does not touch the lp solver.
+    Improving solutions are kept until the node loop collects them, since
+    the knowledge broker may only be used from the main thread.
+    Where POSIX threads are not available start() fails, and the
+    heuristics run at the nodes as usual.
+*/
+class BlisHeurWorker {
+
+ private:
+
+    /** Heuristic clones owned by the thread. */
+    std::vector<BlisHeuristic *> heuristics_;
+
+    /** Number of columns. */
+    int numCols_;
+
+    /** Max number of snapshots waiting. */
+    int maxQueue_;
+
+    /** Snapshots waiting, oldest first. */
+    std::deque<BlisHeurSnapshot *> queue_;
+
+    /** Improving solutions not collected yet. */
+    std::deque<BlisHeurSnapshot *> found_;
+
+    /** Snapshots to reuse. */
+    std::vector<BlisHeurSnapshot *> free_;
+
+    /** Best solution value known to the thread, minimization form. */
+    double incumbent_;
+
+    /** Number of snapshots dropped because the queue was full. */
+    int numDropped_;
+
+    /** Set to make the thread exit. */
+    bool stop_;
+
+    /** If the thread was started. */
+    bool running_;
+
+    /** Thread, mutex and condition variable. */
+    struct Sync;
+    Sync *sync_;
+
+    /** Lock and unlock the mutex, wake up the thread. */
+    void lock();
+    void unlock();
+    void wake();
+
+    /** Thread entry, arg is the worker. */
+    static void * run(void *arg);
+
+    /** Take snapshots from the queue and search them until stopped. */
+    void loop();
+
+    /** Get an empty snapshot, the mutex must be held. */
+    BlisHeurSnapshot * getSnapshot();
+
+    /** No copy constructor, assignment operator. */
+    BlisHeurWorker(const BlisHeurWorker&);
+    BlisHeurWorker& operator=(const BlisHeurWorker&);
+
+ public:
+
+    /** Clone the heuristics of model, which must be set up. */
+    BlisHeurWorker(BlisModel *model, int maxQueue);
+
+    /** Stop and join the thread. */
+    ~BlisHeurWorker();
+
+    /** Start the thread, return false if it can not be created. */
+    bool start();
+
+    /** Queue a snapshot of a node lp. incumbent is the best known
+        solution value, minimization form. */
+    void post(const double *lower,
+              const double *upper,
+              const double *lpSolution,
+              double lpValue,
+              double incumbent);
+
+    /** Take the oldest solution found. x must hold the number of columns.
+        Return false if there is none. */
+    bool collect(double &value, double *x);
+
+    /** Number of snapshots dropped because the queue was full. */
+    int getNumDropped() const { return numDropped_; }
+};
+
+#endif
@@ -36,6 +36,8 @@
 #include "CoinPackedMatrix.hpp"
 #include "OsiCuts.hpp"
 
+#include "Blis.h"
+
 class BlisModel;
 
 
@@ -147,6 +149,24 @@ class BlisHeuristic {
                                double * newSolution,
                                OsiCuts & cs) { return 0; }
 
+    /** Search a solution from a snapshot of a node lp: column bounds,
+        solution and objective value (minimization form). Called on a
+        clone from the heuristic thread, so the lp solver must not be
+        used. Return true with the solution and its value if better than
+        the objectiveValue passed in, false if none or not supported. */
+    virtual bool searchSnapshot(const double * lower,
+                                const double * upper,
+                                const double * lpSolution,
+                                double lpValue,
+                                double & objectiveValue,
+                                double * newSolution) { return false; }
+
+    /** Return true if searchSnapshot is implemented. */
+    virtual bool hasSnapshotSearch() const { return false; }
+
+    /** How solutions found by this heuristic are reported. */
+    virtual BLIS_SOL_TYPE solType() const { return BLIS_SOL_ROUNDING; }
+
     /** Number of solutions found. */
     int numSolutions() { return numSolutions_; }
 
@@ -155,6 +175,40 @@ class BlisHeuristic {
 
     /** Cpu time used. */
     inline int calls() { return calls_; }
+
+    /** Return true if this heuristic is due at a node of the given depth
+        after numNodes nodes were processed. Enabled heuristics are always
+        called at the root. With the automatic strategy the node interval
+        grows with the number of calls that found nothing. */
+    bool scheduled(int numNodes, int depth) const {
+        if (strategy_ == -2) {
+            return false;
+        }
+        if (depth == 0) {
+            return true;
+        }
+        if (strategy_ == -1) {
+            return false;
+        }
+        if (strategy_ > 0) {
+            return (numNodes % strategy_) == 0;
+        }
+        int interval = 1 + calls_ / (10 * (numSolutions_ + 1));
+        if (interval > 1000) {
+            interval = 1000;
+        }
+        return (numNodes % interval) == 0;
+    }
+
+    /** Average cpu time of a call, 0 if never called. */
+    double averageTime() const {
+        return (calls_ > 0) ? time_ / calls_ : 0.0;
+    }
+
+    /** Solutions found per cpu second, used to order the calls. */
+    double efficiency() const {
+        return (numSolutions_ + 1.0) / (time_ + 1.0e-3);
+    }
 };
 
 #endif
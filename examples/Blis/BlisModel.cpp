@@ -21,8 +21,41 @@
  * All Rights Reserved.                                                      *
  *===========================================================================*/
 
+#include "BlisConfig.h"
+
 #include "float.h"
 
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <ctime>
+#include <sstream>
+
+#include <sys/stat.h>
+#ifdef HAVE_FCNTL_H
+#include <fcntl.h>
+#endif
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#elif defined(_WIN32)
+#include <process.h>
+#endif
+
+// Files are mapped into memory where POSIX mmap is available, read with
+// stdio otherwise.
+#if defined(HAVE_FCNTL_H) && defined(HAVE_SYS_MMAN_H) && defined(HAVE_UNISTD_H)
+#define BLIS_HAS_MMAP 1
+#endif
+
+// Ranks share core data through POSIX shared memory where it is available.
+// Otherwise every rank keeps the data it decoded.
+#if defined(BLIS_HAS_MMAP) && defined(HAVE_SHM_OPEN)
+#define BLIS_HAS_SHM 1
+#endif
+
 #include "CoinFinite.hpp"
 #include "CoinTime.hpp"
 #include "OsiClpSolverInterface.hpp"
@@ -40,14 +73,21 @@
 
 #include "BlisBranchObjectInt.h"
 #include "BlisBranchStrategyPseudo.h"
-//#include "BlisBranchStrategyRel.h"
-//#include "BlisBranchStrategyStrong.h"
+#include "BlisBranchStrategyRel.h"
+#include "BlisBranchStrategyStrong.h"
 
 #include "BlisConstraint.h"
+#include "BlisHeurDive.h"
+#include "BlisHeurFPump.h"
 #include "BlisHeurRound.h"
+#include "BlisHeurWorker.h"
 #include "BlisModel.h"
+#include "BlisMpsReader.h"
 #include "BlisObjectInt.h"
+#include "BlisPresolve.h"
+#include "BlisPropagator.h"
 #include "BlisSolution.h"
+#include "BlisSolutionPool.h"
 #include "BlisTreeNode.h"
 #include "BlisVariable.h"
 
@@ -61,6 +101,7 @@ BlisModel::init()
     numRows_ = 0;
     numElems_ = 0;
     colMatrix_ = 0;
+    rowMatrix_ = 0;
 
     origVarLB_ = NULL;
     origVarUB_ = NULL;
@@ -77,6 +118,9 @@ BlisModel::init()
     tempConLBPos_ = NULL;
     tempConUBPos_ = NULL;
 
+    colBoundInd_ = NULL;
+    colBoundVal_ = NULL;
+
     objSense_ = 1.0;
     objCoef_ = NULL;
 
@@ -84,6 +128,13 @@ BlisModel::init()
     numIntVars_ = 0;
     intVars_ = NULL;
 
+    cacheImage_ = NULL;
+    cacheImageSize_ = 0;
+    sharedImage_ = NULL;
+    sharedImageSize_ = 0;
+
+    presolve_ = NULL;
+
     numSolutions_ = 0;
     numHeurSolutions_ = 0;
 
@@ -101,10 +152,20 @@ BlisModel::init()
     numObjects_ = 0;
 
     numNodes_ = 0;
+
+    poolMemory_ = 0;
+    numSpilled_ = 0;
+    spillFile_ = NULL;
+    sharedCutoff_ = ALPS_OBJ_MAX;
     numIterations_ = 0;
     aveIterations_ = 0;
 
     branchStrategy_ = NULL;
+    propagator_ = NULL;
+    rootLpValue_ = 0.0;
+    globalFixCutoff_ = ALPS_OBJ_MAX;
+    globalVarLB_ = NULL;
+    globalVarUB_ = NULL;
     priority_ = NULL;
     nodeWeight_ = 1.0;
 
@@ -125,6 +186,8 @@ BlisModel::init()
     useHeuristics_ = true;
     numHeuristics_ = 0;
     heuristics_ = NULL;
+    heurWorker_ = NULL;
+    solPool_ = NULL;
 
     /// Cons related
     useCons_ = 0;
@@ -144,55 +207,128 @@ BlisModel::init()
 void
 BlisModel::readInstance(const char* dataFile)
 {
-    int j;
+    //------------------------------------------------------
+    // Try the binary instance cache first.
+    //------------------------------------------------------
+
+    bool useCache = BlisPar_->entry(BlisParams::instanceCache);
+    std::string cacheFile = std::string(dataFile) + ".bbin";
+
+    if (useCache && readInstanceCache(dataFile, cacheFile.c_str())) {
+        std::cout << "Read instance from cache " << cacheFile
+                  << std::endl;
+    }
+    else {
+        readMpsInstance(dataFile);
+        if (useCache) {
+            writeInstanceCache(dataFile, cacheFile.c_str());
+        }
+    }
 
     //------------------------------------------------------
-    // Read in data from MPS file.
+    // Do root preprocessing.
+    //------------------------------------------------------
+
+    if (BlisPar_->entry(BlisParams::presolvePass) > 0) {
+        presolveInstance();
+    }
+
+    //------------------------------------------------------
+    // load problem to lp solver.
     //------------------------------------------------------
 
-    CoinMpsIO *mps = new CoinMpsIO;
-    int rc = mps->readMps(dataFile, "");
-    if(rc) {
-        delete mps;
-        throw CoinError("Unable to read in instance",
-                        "readInstance",
-                        "BlisModel");
+    if (!lpSolver_) {
+        lpSolver_ = new OsiClpSolverInterface();
     }
 
+    lpSolver_->loadProblem(*colMatrix_,
+			   origVarLB_, origVarUB_,
+			   objCoef_,
+			   origConLB_, origConUB_);
+
+    lpSolver_->setObjSense(objSense_);
+    lpSolver_->setInteger(intVars_, numIntVars_);
+    if (presolve_) {
+        // Osi subtracts the offset from c'x.
+        lpSolver_->setDblParam(OsiObjOffset, -presolve_->getObjOffset());
+    }
+
+    if (numIntVars_ == 0) {
+	// solve lp and throw error.
+	lpSolver_->initialSolve();
+	throw CoinError("Input instance is a LP",
+			"readInstance", "BlisModel");
+    }
+}
+
+//############################################################################
+
+/** Read in instance data from an MPS file. The streaming reader is
+    tried first, CoinMpsIO reads files it does not support. */
+void
+BlisModel::readMpsInstance(const char* dataFile)
+{
+    int j;
 
     //------------------------------------------------------
-    // Get problem data.
+    // Read in data from MPS file.
     //------------------------------------------------------
 
-    numCols_ = mps->getNumCols();
-    numRows_ = mps->getNumRows();
-    numElems_ = mps->getNumElements();
+    BlisMpsReader reader;
+    CoinMpsIO *mps = NULL;
 
-    colMatrix_ = new CoinPackedMatrix();
-    *colMatrix_ = *(mps->getMatrixByCol());
+    int rc = reader.readMps(dataFile);
+    if (rc == 0) {
+        numCols_ = reader.getNumCols();
+        numRows_ = reader.getNumRows();
+        numElems_ = reader.getNumElements();
+
+        // Matrix and column data are handed over, not copied.
+        colMatrix_ = reader.releaseMatrix();
+        origVarLB_ = reader.releaseColLower();
+        origVarUB_ = reader.releaseColUpper();
+        reader.getRowBounds(origConLB_, origConUB_);
+        objCoef_ = reader.releaseObjective();
+    }
+    else {
+        mps = new CoinMpsIO;
+        rc = mps->readMps(dataFile, "");
+        if(rc) {
+            delete mps;
+            throw CoinError("Unable to read in instance",
+                            "readInstance",
+                            "BlisModel");
+        }
 
-    origVarLB_ = new double [numCols_];
-    origVarUB_ = new double [numCols_];
+        //--------------------------------------------------
+        // Get problem data.
+        //--------------------------------------------------
 
-    origConLB_ = new double [numRows_];
-    origConUB_ = new double [numRows_];
+        numCols_ = mps->getNumCols();
+        numRows_ = mps->getNumRows();
+        numElems_ = mps->getNumElements();
 
-    memcpy(origVarLB_, mps->getColLower(), sizeof(double) * numCols_);
-    memcpy(origVarUB_, mps->getColUpper(), sizeof(double) * numCols_);
+        colMatrix_ = new CoinPackedMatrix();
+        *colMatrix_ = *(mps->getMatrixByCol());
 
-    memcpy(origConLB_, mps->getRowLower(), sizeof(double) * numRows_);
-    memcpy(origConUB_, mps->getRowUpper(), sizeof(double) * numRows_);
+        origVarLB_ = new double [numCols_];
+        origVarUB_ = new double [numCols_];
 
-    //memcpy(startVarLB_, mps->getColLower(), sizeof(double) * numCols_);
-    //memcpy(startVarUB_, mps->getColUpper(), sizeof(double) * numCols_);
+        origConLB_ = new double [numRows_];
+        origConUB_ = new double [numRows_];
 
-    //memcpy(startConLB_, mps->getRowLower(), sizeof(double) * numRows_);
-    //memcpy(startConUB_, mps->getRowUpper(), sizeof(double) * numRows_);
+        memcpy(origVarLB_, mps->getColLower(), sizeof(double) * numCols_);
+        memcpy(origVarUB_, mps->getColUpper(), sizeof(double) * numCols_);
 
-    objSense_ = 1.0; /* Default from MPS is minimization */
+        memcpy(origConLB_, mps->getRowLower(), sizeof(double) * numRows_);
+        memcpy(origConUB_, mps->getRowUpper(), sizeof(double) * numRows_);
 
-    objCoef_ = new double [numCols_];
-    memcpy(objCoef_, mps->getObjCoefficients(), sizeof(double) * numCols_);
+        objCoef_ = new double [numCols_];
+        memcpy(objCoef_, mps->getObjCoefficients(),
+               sizeof(double) * numCols_);
+    }
+
+    objSense_ = 1.0; /* Default from MPS is minimization */
 
     //------------------------------------------------------
     // Classify variable type.
@@ -202,7 +338,8 @@ BlisModel::readInstance(const char* dataFile)
     intVars_ = new int [numCols_];
     numIntVars_ = 0;
     for(j = 0; j < numCols_; ++j) {
-	if (mps->isContinuous(j)) {
+        bool isContinuous = mps ? mps->isContinuous(j) : !reader.isInteger(j);
+	if (isContinuous) {
 	    colType_[j] = 'C';
 	}
 	else {
@@ -216,36 +353,577 @@ BlisModel::readInstance(const char* dataFile)
 	}
     }
 
-    //------------------------------------------------------
-    // Do root preprocessing.
-    //------------------------------------------------------
+    delete mps;
+}
 
+//############################################################################
 
-    //------------------------------------------------------
-    // load problem to lp solver.
-    // NOTE: since no presolve, load original one.
-    //------------------------------------------------------
+/** Header of the binary instance cache. The arrays follow the header in
+    the order elements, column lower, column upper, row lower, row upper,
+    objective (double), column starts (CoinBigIndex), row indices, integer
+    variables (int), column types (char), column lengths (int), each
+    starting at a multiple of 8 bytes. This is the layout the model uses
+    in memory, so a mapped cache is used in place. The size and
+    modification time of the source file are recorded so that a stale
+    cache is ignored. */
+struct BlisInstanceCacheHeader {
+    char magic[8];
+    int version;
+    int sizeOfInt;
+    int sizeOfBigIndex;
+    int sizeOfDouble;
+    long long sourceSize;
+    long long sourceTime;
+    long long numElems;
+    int numCols;
+    int numRows;
+    int numIntVars;
+    int pad;
+};
 
-    if (!lpSolver_) {
-        lpSolver_ = new OsiClpSolverInterface();
+static const char BLIS_CACHE_MAGIC[8] = "BLISBIN";
+static const int BLIS_CACHE_VERSION = 2;
+
+/** Number of arrays in an instance image. */
+static const int BLIS_CACHE_ARRAYS = 11;
+
+/** Round up to the next multiple of 8. */
+static size_t
+BlisCacheAlign(size_t offset)
+{
+    return (offset + 7) & ~static_cast<size_t>(7);
+}
+
+/** Compute the offsets of the arrays in a cache file and return the
+    total size of the file. */
+static size_t
+BlisCacheOffsets(const BlisInstanceCacheHeader &header, size_t *offset)
+{
+    size_t numCols = header.numCols;
+    size_t numRows = header.numRows;
+    size_t numElems = static_cast<size_t>(header.numElems);
+    size_t size[BLIS_CACHE_ARRAYS] = {
+        numElems * sizeof(double),
+        numCols * sizeof(double),
+        numCols * sizeof(double),
+        numRows * sizeof(double),
+        numRows * sizeof(double),
+        numCols * sizeof(double),
+        (numCols + 1) * sizeof(CoinBigIndex),
+        numElems * sizeof(int),
+        header.numIntVars * sizeof(int),
+        numCols * sizeof(char),
+        numCols * sizeof(int)
+    };
+    size_t pos = BlisCacheAlign(sizeof(BlisInstanceCacheHeader));
+    for (int k = 0; k < BLIS_CACHE_ARRAYS; ++k) {
+        offset[k] = pos;
+        pos = BlisCacheAlign(pos + size[k]);
     }
+    return pos;
+}
 
-    lpSolver_->loadProblem(*colMatrix_,
-			   origVarLB_, origVarUB_,
-			   objCoef_,
-			   origConLB_, origConUB_);
+/** Set up an image header for the given problem size. */
+static void
+BlisInitInstanceHeader(BlisInstanceCacheHeader &header, int numCols,
+                       int numRows, CoinBigIndex numElems, int numIntVars)
+{
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, BLIS_CACHE_MAGIC, 8);
+    header.version = BLIS_CACHE_VERSION;
+    header.sizeOfInt = sizeof(int);
+    header.sizeOfBigIndex = sizeof(CoinBigIndex);
+    header.sizeOfDouble = sizeof(double);
+    header.numElems = numElems;
+    header.numCols = numCols;
+    header.numRows = numRows;
+    header.numIntVars = numIntVars;
+}
 
-    lpSolver_->setObjSense(objSense_);
-    lpSolver_->setInteger(intVars_, numIntVars_);
+/** Fill the arrays of an instance image at the offsets given by
+    BlisCacheOffsets. The header is left to the caller. If lengths is NULL,
+    the column starts have no gaps. If elements is NULL, the matrix is
+    left out and the column starts stay zero. */
+static void
+BlisFillInstanceImage(char *image, const BlisInstanceCacheHeader &header,
+                      const double *elements, const int *indices,
+                      const CoinBigIndex *matStart, const int *matLength,
+                      const double *colLB, const double *colUB,
+                      const double *rowLB, const double *rowUB,
+                      const double *obj, const int *intVars,
+                      const char *colType)
+{
+    size_t offset[BLIS_CACHE_ARRAYS];
+    BlisCacheOffsets(header, offset);
+
+    int numCols = header.numCols;
+    int numRows = header.numRows;
+
+    // Gather the column major matrix without gaps.
+    double *imageElements = reinterpret_cast<double *>(image + offset[0]);
+    CoinBigIndex *starts = reinterpret_cast<CoinBigIndex *>(image + offset[6]);
+    int *imageIndices = reinterpret_cast<int *>(image + offset[7]);
+    int *lengths = reinterpret_cast<int *>(image + offset[10]);
+
+    CoinBigIndex pos = 0;
+    for (int j = 0; j < numCols; ++j) {
+        starts[j] = pos;
+        lengths[j] = 0;
+        if (!elements) continue;
+        int len = matLength ? matLength[j] : matStart[j + 1] - matStart[j];
+        lengths[j] = len;
+        memcpy(imageElements + pos, elements + matStart[j],
+               sizeof(double) * len);
+        memcpy(imageIndices + pos, indices + matStart[j], sizeof(int) * len);
+        pos += len;
+    }
+    starts[numCols] = pos;
+
+    memcpy(image + offset[1], colLB, sizeof(double) * numCols);
+    memcpy(image + offset[2], colUB, sizeof(double) * numCols);
+    memcpy(image + offset[3], rowLB, sizeof(double) * numRows);
+    memcpy(image + offset[4], rowUB, sizeof(double) * numRows);
+    memcpy(image + offset[5], obj, sizeof(double) * numCols);
+    memcpy(image + offset[8], intVars, sizeof(int) * header.numIntVars);
+    memcpy(image + offset[9], colType, sizeof(char) * numCols);
+}
 
-    delete mps;
+//############################################################################
 
-    if (numIntVars_ == 0) {
-	// solve lp and throw error.
-	lpSolver_->initialSolve();
-	throw CoinError("Input instance is a LP",
-			"readInstance", "BlisModel");
+/** Id of this process, used to make local file names unique. */
+static long
+BlisProcessId()
+{
+#if defined(HAVE_UNISTD_H)
+    return static_cast<long>(getpid());
+#elif defined(_WIN32)
+    return static_cast<long>(_getpid());
+#else
+    return static_cast<long>(time(NULL));
+#endif
+}
+
+/** Map the whole file into memory, or read it into a buffer where mmap is
+    not available. The mapping is private, a page written to is copied and
+    the file is never changed. Return NULL on failure. The image must be
+    released with BlisUnmapFile. */
+static char *
+BlisMapFile(const char *fileName, size_t &length)
+{
+#ifdef BLIS_HAS_MMAP
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+    struct stat file;
+    if (fstat(fd, &file) != 0 || file.st_size <= 0) {
+        close(fd);
+        return NULL;
+    }
+    length = static_cast<size_t>(file.st_size);
+    void *map = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                     fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return NULL;
+    }
+    return static_cast<char *>(map);
+#else
+    FILE *fp = fopen(fileName, "rb");
+    if (!fp) {
+        return NULL;
+    }
+    char *buffer = NULL;
+    long size = -1;
+    if (fseek(fp, 0, SEEK_END) == 0) {
+        size = ftell(fp);
+    }
+    if (size > 0 && fseek(fp, 0, SEEK_SET) == 0) {
+        length = static_cast<size_t>(size);
+        buffer = new char [length];
+        if (fread(buffer, 1, length, fp) != length) {
+            delete [] buffer;
+            buffer = NULL;
+        }
+    }
+    fclose(fp);
+    return buffer;
+#endif
+}
+
+/** Release an image returned by BlisMapFile. */
+static void
+BlisUnmapFile(char *image, size_t length)
+{
+#ifdef BLIS_HAS_MMAP
+    munmap(image, length);
+#else
+    delete [] image;
+#endif
+}
+
+//############################################################################
+
+/** Load instance data from a binary cache written by writeInstanceCache.
+    The cache stays mapped, the core matrix and arrays point into it and
+    only pages that are used are read. The cache is replaced by renaming,
+    so the mapped file never changes. Return false if the cache is
+    missing, stale or of another format. */
+bool
+BlisModel::readInstanceCache(const char *dataFile, const char *cacheFile)
+{
+    struct stat source;
+    if (stat(dataFile, &source) != 0) {
+        return false;
+    }
+
+    size_t length = 0;
+    char *base = BlisMapFile(cacheFile, length);
+    if (!base) {
+        return false;
+    }
+    if (length < sizeof(BlisInstanceCacheHeader)) {
+        BlisUnmapFile(base, length);
+        return false;
+    }
+
+    const BlisInstanceCacheHeader *header =
+        reinterpret_cast<const BlisInstanceCacheHeader *>(base);
+
+    size_t offset[BLIS_CACHE_ARRAYS];
+    if (memcmp(header->magic, BLIS_CACHE_MAGIC, 8) != 0 ||
+        header->version != BLIS_CACHE_VERSION ||
+        header->sizeOfInt != static_cast<int>(sizeof(int)) ||
+        header->sizeOfBigIndex != static_cast<int>(sizeof(CoinBigIndex)) ||
+        header->sizeOfDouble != static_cast<int>(sizeof(double)) ||
+        header->sourceSize != static_cast<long long>(source.st_size) ||
+        header->sourceTime != static_cast<long long>(source.st_mtime) ||
+        BlisCacheOffsets(*header, offset) != length) {
+        BlisUnmapFile(base, length);
+        return false;
+    }
+
+    numCols_ = header->numCols;
+    numRows_ = header->numRows;
+    numElems_ = static_cast<int>(header->numElems);
+    numIntVars_ = header->numIntVars;
+
+    cacheImage_ = base;
+    cacheImageSize_ = length;
+
+    double *elements = reinterpret_cast<double *>(base + offset[0]);
+    CoinBigIndex *starts = reinterpret_cast<CoinBigIndex *>(base + offset[6]);
+    int *indices = reinterpret_cast<int *>(base + offset[7]);
+    int *lengths = reinterpret_cast<int *>(base + offset[10]);
+
+    // The matrix borrows its arrays, freeColMatrix() gives them back.
+    colMatrix_ = new CoinPackedMatrix();
+    colMatrix_->assignMatrix(true, numRows_, numCols_, numElems_,
+                             elements, indices, starts, lengths);
+
+    origVarLB_ = reinterpret_cast<double *>(base + offset[1]);
+    origVarUB_ = reinterpret_cast<double *>(base + offset[2]);
+    origConLB_ = reinterpret_cast<double *>(base + offset[3]);
+    origConUB_ = reinterpret_cast<double *>(base + offset[4]);
+    objCoef_ = reinterpret_cast<double *>(base + offset[5]);
+    intVars_ = reinterpret_cast<int *>(base + offset[8]);
+    colType_ = base + offset[9];
+
+    objSense_ = 1.0; /* Default from MPS is minimization */
+
+    return true;
+}
+
+//############################################################################
+
+bool
+BlisModel::isImageData(const void *p) const
+{
+    const char *q = static_cast<const char *>(p);
+    if (cacheImage_ && q >= cacheImage_ && q < cacheImage_ + cacheImageSize_) {
+        return true;
+    }
+    const char *shared = static_cast<const char *>(sharedImage_);
+    if (shared && q >= shared && q < shared + sharedImageSize_) {
+        return true;
+    }
+    return false;
+}
+
+//############################################################################
+
+void
+BlisModel::freeColMatrix()
+{
+    if (colMatrix_ && isImageData(colMatrix_->getElements())) {
+        // Only the matrix object is ours.
+        colMatrix_->releasePackedMatrix();
+    }
+    delete colMatrix_;
+    colMatrix_ = NULL;
+}
+
+//############################################################################
+
+void
+BlisModel::releaseCacheImage()
+{
+    if (cacheImage_) {
+        BlisUnmapFile(cacheImage_, cacheImageSize_);
+        cacheImage_ = NULL;
+        cacheImageSize_ = 0;
+    }
+}
+
+//############################################################################
+
+/** Write instance data to a binary cache. The file is written under a
+    temporary name and renamed, so concurrent readers never see a partial
+    cache. Failure to write is not an error. */
+void
+BlisModel::writeInstanceCache(const char *dataFile,
+                              const char *cacheFile) const
+{
+    struct stat source;
+    if (stat(dataFile, &source) != 0) {
+        return;
+    }
+
+    BlisInstanceCacheHeader header;
+    BlisInitInstanceHeader(header, numCols_, numRows_,
+                           colMatrix_->getNumElements(), numIntVars_);
+    header.sourceSize = static_cast<long long>(source.st_size);
+    header.sourceTime = static_cast<long long>(source.st_mtime);
+
+    size_t offset[BLIS_CACHE_ARRAYS];
+    size_t length = BlisCacheOffsets(header, offset);
+
+    char *buffer = new char [length];
+    memset(buffer, 0, length);
+    memcpy(buffer, &header, sizeof(header));
+
+    BlisFillInstanceImage(buffer, header,
+                          colMatrix_->getElements(),
+                          colMatrix_->getIndices(),
+                          colMatrix_->getVectorStarts(),
+                          colMatrix_->getVectorLengths(),
+                          origVarLB_, origVarUB_, origConLB_, origConUB_,
+                          objCoef_, intVars_, colType_);
+
+    std::ostringstream tmpName;
+    tmpName << cacheFile << "." << BlisProcessId();
+
+    FILE *fp = fopen(tmpName.str().c_str(), "wb");
+    if (fp) {
+        bool ok = (fwrite(buffer, 1, length, fp) == length);
+        ok = (fclose(fp) == 0) && ok;
+        if (!ok || rename(tmpName.str().c_str(), cacheFile) != 0) {
+            remove(tmpName.str().c_str());
+        }
+    }
+
+    delete [] buffer;
+}
+
+//############################################################################
+
+/** Replace the decoded column matrix, bounds, objective and column types
+    by a read-only image in the POSIX shared memory segment name. The
+    first rank on a host to get here creates and fills the segment, the
+    others wait for it and map it. On success the private arrays are freed,
+    they and the arrays of colMatrix_ point into the image. The lp solver
+    still loads its own copy of the matrix, and setupSelf() builds a
+    private row ordered copy. Return false and leave everything unchanged
+    if the segment can not be used or shared memory is not available on
+    this platform. */
+bool
+BlisModel::attachSharedModel(const char *name)
+{
+#ifdef BLIS_HAS_SHM
+    BlisInstanceCacheHeader header;
+    BlisInitInstanceHeader(header, numCols_, numRows_,
+                           colMatrix_->getNumElements(), numIntVars_);
+
+    size_t offset[BLIS_CACHE_ARRAYS];
+    size_t length = BlisCacheOffsets(header, offset);
+
+    bool owner = false;
+    void *map = MAP_FAILED;
+
+    int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd >= 0) {
+        owner = true;
+        if (ftruncate(fd, static_cast<off_t>(length)) == 0) {
+            map = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED,
+                       fd, 0);
+        }
+        close(fd);
+        if (map == MAP_FAILED) {
+            shm_unlink(name);
+            return false;
+        }
+
+        char *image = static_cast<char *>(map);
+        BlisFillInstanceImage(image, header,
+                              colMatrix_->getElements(),
+                              colMatrix_->getIndices(),
+                              colMatrix_->getVectorStarts(),
+                              colMatrix_->getVectorLengths(),
+                              origVarLB_, origVarUB_,
+                              origConLB_, origConUB_, objCoef_,
+                              intVars_, colType_);
+        // The header goes last, it tells the others the image is ready.
+        memcpy(image, &header, sizeof(header));
+        mprotect(map, length, PROT_READ);
+    }
+    else if (errno == EEXIST) {
+        fd = shm_open(name, O_RDONLY, 0);
+        if (fd < 0) {
+            return false;
+        }
+
+        // Wait for the owner to size and fill the segment.
+        bool ready = false;
+        for (int k = 0; k < 600 && !ready; ++k) {
+            struct stat segment;
+            if (map == MAP_FAILED) {
+                if (fstat(fd, &segment) == 0 &&
+                    segment.st_size == static_cast<off_t>(length)) {
+                    map = mmap(NULL, length, PROT_READ, MAP_SHARED, fd, 0);
+                }
+            }
+            if (map != MAP_FAILED) {
+                ready = (memcmp(map, &header, sizeof(header)) == 0);
+            }
+            if (!ready) {
+                usleep(100000);
+            }
+        }
+        close(fd);
+
+        if (!ready) {
+            if (map != MAP_FAILED) {
+                munmap(map, length);
+            }
+            return false;
+        }
+    }
+    else {
+        return false;
+    }
+
+    char *base = static_cast<char *>(map);
+
+    freeColMatrix();
+    freeCoreArray(origVarLB_);
+    freeCoreArray(origVarUB_);
+    freeCoreArray(origConLB_);
+    freeCoreArray(origConUB_);
+    freeCoreArray(objCoef_);
+    freeCoreArray(colType_);
+
+    double *elements = reinterpret_cast<double *>(base + offset[0]);
+    CoinBigIndex *starts = reinterpret_cast<CoinBigIndex *>(base + offset[6]);
+    int *indices = reinterpret_cast<int *>(base + offset[7]);
+    int *lengths = reinterpret_cast<int *>(base + offset[10]);
+
+    // The matrix borrows its arrays, freeColMatrix() gives them back.
+    colMatrix_ = new CoinPackedMatrix();
+    colMatrix_->assignMatrix(true, numRows_, numCols_, numElems_,
+                             elements, indices, starts, lengths);
+
+    origVarLB_ = reinterpret_cast<double *>(base + offset[1]);
+    origVarUB_ = reinterpret_cast<double *>(base + offset[2]);
+    origConLB_ = reinterpret_cast<double *>(base + offset[3]);
+    origConUB_ = reinterpret_cast<double *>(base + offset[4]);
+    objCoef_ = reinterpret_cast<double *>(base + offset[5]);
+    colType_ = base + offset[9];
+
+    sharedImage_ = map;
+    sharedImageSize_ = length;
+    if (owner) {
+        sharedImageName_ = name;
+    }
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+//############################################################################
+
+void
+BlisModel::presolveInstance()
+{
+    int j;
+
+    presolve_ = new BlisPresolve;
+
+    int status = presolve_->presolve(*colMatrix_,
+                                     origVarLB_, origVarUB_,
+                                     objCoef_,
+                                     origConLB_, origConUB_,
+                                     colType_,
+                                     objSense_,
+                                     BlisPar_->entry(BlisParams::presolvePass));
+
+    if (status != 0) {
+        if (status < 0) {
+            std::cout << "Presolve: problem seems infeasible, "
+                      << "solve the original one." << std::endl;
+        }
+        else {
+            std::cout << "Presolve: no reduction." << std::endl;
+        }
+        delete presolve_;
+        presolve_ = NULL;
+        return;
+    }
+
+    std::cout << "Presolve: removed "
+              << numCols_ - presolve_->getNumCols() << " columns and "
+              << numRows_ - presolve_->getNumRows() << " rows, tightened "
+              << presolve_->getNumTightenedBounds() << " bounds and "
+              << presolve_->getNumTightenedCoefs() << " coefficients; "
+              << "objective offset " << presolve_->getObjOffset()
+              << std::endl;
+
+    //------------------------------------------------------
+    // Replace the core problem.
+    //------------------------------------------------------
+
+    freeColMatrix();
+    colMatrix_ = presolve_->releaseMatrix();
+
+    freeCoreArray(origVarLB_);
+    origVarLB_ = presolve_->releaseColLower();
+    freeCoreArray(origVarUB_);
+    origVarUB_ = presolve_->releaseColUpper();
+    freeCoreArray(origConLB_);
+    origConLB_ = presolve_->releaseRowLower();
+    freeCoreArray(origConUB_);
+    origConUB_ = presolve_->releaseRowUpper();
+    freeCoreArray(objCoef_);
+    objCoef_ = presolve_->releaseObjective();
+    freeCoreArray(colType_);
+    colType_ = presolve_->releaseColType();
+
+    numCols_ = presolve_->getNumCols();
+    numRows_ = presolve_->getNumRows();
+    numElems_ = colMatrix_->getNumElements();
+
+    freeCoreArray(intVars_);
+    intVars_ = new int [numCols_];
+    numIntVars_ = 0;
+    for (j = 0; j < numCols_; ++j) {
+        if (colType_[j] != 'C') {
+            intVars_[numIntVars_++] = j;
+        }
     }
+
+    // Nothing points into the instance cache any more.
+    releaseCacheImage();
 }
 
 //############################################################################
@@ -307,6 +985,9 @@ BlisModel::setupSelf()
     tempConLBPos_ = new int [numRows_];
     tempConUBPos_ = new int [numRows_];
 
+    colBoundInd_ = new int [numCols_];
+    colBoundVal_ = new double [2 * numCols_];
+
     //------------------------------------------------------
     // Get parameters.
     //------------------------------------------------------
@@ -395,22 +1076,57 @@ BlisModel::setupSelf()
     }
     else if (brStrategy == 2) {
         // Relibility
-        //branchStrategy_ =  new BlisBranchStrategyRel(this, relibility);
+        branchStrategy_ =  new BlisBranchStrategyRel(this, relibility);
     }
     else if (brStrategy == 3) {
         // Strong
-        //branchStrategy_ =  new BlisBranchStrategyStrong(this);
+        branchStrategy_ =  new BlisBranchStrategyStrong(this);
     }
     else {
         throw CoinError("Unknown branch strategy.", "setupSelf","BlisModel");
     }
 
+    //------------------------------------------------------
+    // Core matrix by column and by row, one copy for all users. The lp
+    // only holds the core rows at this point.
+    //------------------------------------------------------
+
+    if (!colMatrix_) {
+        colMatrix_ = new CoinPackedMatrix(*(lpSolver_->getMatrixByCol()));
+    }
+    assert(colMatrix_->isColOrdered());
+    delete rowMatrix_;
+    rowMatrix_ = new CoinPackedMatrix();
+    rowMatrix_->reverseOrderedCopyOf(*colMatrix_);
+
+    //------------------------------------------------------
+    // Domain propagation.
+    //------------------------------------------------------
+
+    if (BlisPar_->entry(BlisParams::propagatePass) > 0) {
+        propagator_ = new BlisPropagator(*rowMatrix_, *colMatrix_,
+                                         origConLB_, origConUB_,
+                                         colType_,
+                                         origVarLB_, origVarUB_);
+    }
+
+    //------------------------------------------------------
+    // Solution pool.
+    //------------------------------------------------------
+
+    solPool_ = new BlisSolutionPool(BlisPar_->entry(BlisParams::solPoolSize));
+
     //------------------------------------------------------
     // Add heuristics.
     //------------------------------------------------------
 
     useHeuristics_ = BlisPar_->entry(BlisParams::useHeuristics);
     int useRound = BlisPar_->entry(BlisParams::heurRound);
+    int useDiveFrac = BlisPar_->entry(BlisParams::heurDiveFrac);
+    int useDiveCoef = BlisPar_->entry(BlisParams::heurDiveCoef);
+    int useDivePseudo = BlisPar_->entry(BlisParams::heurDivePseudo);
+    int useDiveGuided = BlisPar_->entry(BlisParams::heurDiveGuided);
+    int useFPump = BlisPar_->entry(BlisParams::heurFPump);
 
     if (useHeuristics_) {
         if (useRound > -2) {
@@ -420,6 +1136,38 @@ BlisModel::setupSelf()
                                                          useRound);
             addHeuristic(heurRound);
         }
+
+        // Add diving heuristics, run on the node lp in the search thread.
+        if (useDiveFrac > -2) {
+            addHeuristic(new BlisHeurDiveFractional(this, "DiveFractional",
+                                                    useDiveFrac));
+        }
+        if (useDiveCoef > -2) {
+            addHeuristic(new BlisHeurDiveCoefficient(this, "DiveCoefficient",
+                                                     useDiveCoef));
+        }
+        if (useDivePseudo > -2) {
+            addHeuristic(new BlisHeurDivePseudocost(this, "DivePseudocost",
+                                                    useDivePseudo));
+        }
+        if (useDiveGuided > -2) {
+            addHeuristic(new BlisHeurDiveGuided(this, "DiveGuided",
+                                                useDiveGuided));
+        }
+
+        // Last, so it only pumps if nothing else found a solution.
+        if (useFPump > -2) {
+            addHeuristic(new BlisHeurFPump(this, "FeasibilityPump",
+                                           useFPump));
+        }
+
+        if (BlisPar_->entry(BlisParams::heurThread) && numHeuristics_ > 0) {
+            heurWorker_ = new BlisHeurWorker(this, 4);
+            if (!heurWorker_->start()) {
+                delete heurWorker_;
+                heurWorker_ = NULL;
+            }
+        }
     }
 
     //------------------------------------------------------
@@ -428,8 +1176,7 @@ BlisModel::setupSelf()
 
     // Compute dense cutoff.
 
-    const CoinPackedMatrix * rowMatrix = lpSolver_->getMatrixByRow();
-    const int * rowLen = rowMatrix->getVectorLengths();
+    const int * rowLen = rowMatrix_->getVectorLengths();
     double maxLen = 0.0, minLen = ALPS_DBL_MAX, sumLen = 0.0;
     double aveLen, diffLen, stdLen;
     double denseConFactor = BlisPar_->entry(BlisParams::denseConFactor);
@@ -605,15 +1352,359 @@ BlisModel::feasibleSolution(int & numIntegerInfs, double & infAmount)
 
     BlisSolution * sol = NULL;
     if (feasible) {
-      sol = new BlisSolution(lpSolver_->getNumCols(),
-                             lpSolver_->getColSolution(),
-                             lpSolver_->getObjValue());
+      sol = createSolution(lpSolver_->getColSolution(),
+                           lpSolver_->getObjValue());
     }
     return sol;
 }
 
 //############################################################################
 
+BlisSolution *
+BlisModel::createSolution(const double *x, double objValue) const
+{
+    // Solutions of large binary problems are mostly zero, store them sparse
+    // so the broker pools and broadcasts them by their nonzeros.
+    const double zeroTol = 1.0e-15;
+
+    if (!presolve_) {
+        return new BlisSolution(lpSolver_->getNumCols(), x, objValue,
+                                zeroTol);
+    }
+
+    int numOrigCols = presolve_->getNumOrigCols();
+    double *origX = new double [numOrigCols];
+    presolve_->postsolve(x, origX);
+
+    BlisSolution *sol = new BlisSolution(numOrigCols, origX, objValue,
+                                         zeroTol);
+    delete [] origX;
+
+    return sol;
+}
+
+//############################################################################
+
+int
+BlisModel::installColBounds(const double *lower, const double *upper)
+{
+    int numChanged = 0;
+    int numCols = lpSolver_->getNumCols();
+    const double *lpLower = lpSolver_->getColLower();
+    const double *lpUpper = lpSolver_->getColUpper();
+
+    assert(numCols <= numCols_);
+
+    for (int j = 0; j < numCols; ++j) {
+        if (lower[j] != lpLower[j] || upper[j] != lpUpper[j]) {
+            colBoundInd_[numChanged] = j;
+            colBoundVal_[2 * numChanged] = lower[j];
+            colBoundVal_[2 * numChanged + 1] = upper[j];
+            ++numChanged;
+        }
+    }
+
+    if (numChanged > 0) {
+        lpSolver_->setColSetBounds(colBoundInd_, colBoundInd_ + numChanged,
+                                   colBoundVal_);
+    }
+
+    return numChanged;
+}
+
+//############################################################################
+
+/** Empty the node spill file. Where ftruncate is not available the file
+    is left as it is, it is only appended to. */
+static void
+BlisTruncateFile(FILE *file)
+{
+#if defined(HAVE_UNISTD_H) && defined(HAVE_FTRUNCATE)
+    fflush(file);
+    if (ftruncate(fileno(file), 0) != 0) {
+        std::cerr << "BLIS: failed to truncate the node spill file"
+                  << std::endl;
+    }
+#endif
+}
+
+//############################################################################
+
+void
+BlisModel::addPoolNode(BlisTreeNode *node)
+{
+    if (node->isPoolTracked()) {
+        return;
+    }
+
+    size_t bytes = node->getDesc()->getMemoryUsage();
+    poolNodes_[node] = bytes;
+    poolMemory_ += bytes;
+    node->setPoolTracked(true);
+}
+
+//############################################################################
+
+void
+BlisModel::restorePoolNode(BlisTreeNode *node)
+{
+    if (!node->isPoolTracked()) {
+        return;
+    }
+
+    BlisNodeDesc *desc = node->getDesc();
+    if (desc->isSpilled()) {
+        desc->unspill(spillFile_);
+        size_t &bytes = poolNodes_[node];
+        size_t restored = desc->getMemoryUsage();
+        poolMemory_ += restored - bytes;
+        bytes = restored;
+        if (--numSpilled_ == 0) {
+            // Nothing left in the file, start it over.
+            BlisTruncateFile(spillFile_);
+        }
+    }
+}
+
+//############################################################################
+
+void
+BlisModel::removePoolNode(BlisTreeNode *node, bool restore)
+{
+    if (!node->isPoolTracked()) {
+        return;
+    }
+
+    if (restore) {
+        restorePoolNode(node);
+    }
+    else if (node->getDesc()->isSpilled()) {
+        // The node is being deleted, its spilled data is dead.
+        if (--numSpilled_ == 0) {
+            BlisTruncateFile(spillFile_);
+        }
+    }
+
+    std::map<BlisTreeNode *, size_t>::iterator pos = poolNodes_.find(node);
+    poolMemory_ -= pos->second;
+    poolNodes_.erase(pos);
+    node->setPoolTracked(false);
+}
+
+//############################################################################
+
+/** The nodes with the worst quality are the last ones the search will come
+    back to, so they are spilled first. Spilling goes down to three quarters
+    of the limit, the next few children then fit without another pass. */
+void
+BlisModel::checkPoolMemory()
+{
+    int limit = BlisPar_->entry(BlisParams::nodeMemoryLimit);
+    if (limit <= 0) {
+        return;
+    }
+
+    size_t budget = static_cast<size_t>(limit) * 1024 * 1024;
+    if (poolMemory_ <= budget) {
+        return;
+    }
+
+    if (!spillFile_) {
+        std::ostringstream name;
+        name << "blis.spill." << BlisProcessId();
+        spillFile_ = fopen(name.str().c_str(), "w+b");
+        if (!spillFile_) {
+            std::cerr << "BLIS: can not open node spill file " << name.str()
+                      << ", node memory limit disabled" << std::endl;
+            BlisPar_->setEntry(BlisParams::nodeMemoryLimit, 0);
+            return;
+        }
+        // Only reached through the open handle, gone when the run ends.
+        remove(name.str().c_str());
+    }
+
+    std::vector<std::pair<double, BlisTreeNode *> > candidates;
+    std::map<BlisTreeNode *, size_t>::iterator pos;
+    for (pos = poolNodes_.begin(); pos != poolNodes_.end(); ++pos) {
+        // Pruned nodes are dropped unread, not worth writing out.
+        if (!pos->first->getDesc()->isSpilled() &&
+            pos->first->getStatus() != AlpsNodeStatusFathomed) {
+            candidates.push_back(std::make_pair(pos->first->getQuality(),
+                                                pos->first));
+        }
+    }
+    std::sort(candidates.begin(), candidates.end());
+
+    size_t target = budget / 4 * 3;
+    int k = static_cast<int>(candidates.size()) - 1;
+    for (; k >= 0 && poolMemory_ > target; --k) {
+        BlisTreeNode *node = candidates[k].second;
+        if (node->getDesc()->spill(spillFile_) == AlpsReturnStatusOk) {
+            // Only the modifications are written and freed, what stays in
+            // memory (the basis) is still counted.
+            size_t &bytes = poolNodes_[node];
+            size_t left = node->getDesc()->getMemoryUsage();
+            poolMemory_ -= bytes - left;
+            bytes = left;
+            ++numSpilled_;
+        }
+    }
+
+#ifdef BLIS_DEBUG
+    std::cout << "BLIS: pool memory " << poolMemory_ << " bytes, "
+              << numSpilled_ << " nodes spilled" << std::endl;
+#endif
+}
+
+//############################################################################
+
+/** Same gap test as BlisTreeNode::process(), which then fathoms the node
+    again before it reads its description. Nodes stay in the pool until
+    Alps takes them out. */
+int
+BlisModel::prunePoolNodes(double cutoff)
+{
+    if (cutoff >= ALPS_OBJ_MAX) {
+        return 0;
+    }
+
+    double relGapLimit = BlisPar_->entry(BlisParams::optimalRelGap);
+    double absGapLimit = BlisPar_->entry(BlisParams::optimalAbsGap);
+    int numPruned = 0;
+
+    std::map<BlisTreeNode *, size_t>::iterator pos;
+    for (pos = poolNodes_.begin(); pos != poolNodes_.end(); ++pos) {
+        BlisTreeNode *node = pos->first;
+        AlpsNodeStatus status = node->getStatus();
+        if (status != AlpsNodeStatusCandidate &&
+            status != AlpsNodeStatusEvaluated) {
+            continue;
+        }
+        double absGap = cutoff - node->getQuality();
+        double relGap = absGap / fabs(cutoff);
+        if (relGapLimit > relGap || absGapLimit > absGap) {
+            node->setStatus(AlpsNodeStatusFathomed);
+            ++numPruned;
+        }
+    }
+
+#ifdef BLIS_DEBUG
+    if (numPruned > 0) {
+        std::cout << "BLIS: pruned " << numPruned << " pool nodes"
+                  << std::endl;
+    }
+#endif
+    return numPruned;
+}
+
+//############################################################################
+
+void
+BlisModel::setRootReducedCosts(const double *solution,
+                               const double *reducedCost,
+                               const double *lower,
+                               const double *upper,
+                               double lpValue)
+{
+    int i, j;
+    const double epInt = 1.0e-5;
+
+    rootFixInd_.clear();
+    rootFixBound_.clear();
+    rootFixDj_.clear();
+
+    for (i = 0; i < numIntVars_; ++i) {
+        j = intVars_[i];
+        double dj = fabs(reducedCost[j]);
+        if (dj < epInt || upper[j] - lower[j] < epInt) continue;
+        if (solution[j] < lower[j] + epInt) {
+            rootFixInd_.push_back(j);
+            rootFixBound_.push_back(lower[j]);
+            rootFixDj_.push_back(dj);
+        }
+        else if (solution[j] > upper[j] - epInt) {
+            rootFixInd_.push_back(j);
+            rootFixBound_.push_back(upper[j]);
+            rootFixDj_.push_back(-dj);
+        }
+    }
+
+    rootLpValue_ = lpValue;
+    globalFixCutoff_ = ALPS_OBJ_MAX;
+}
+
+//############################################################################
+
+int
+BlisModel::updateGlobalBounds(double cutoff)
+{
+    int numChanged = 0;
+
+    if (cutoff >= globalFixCutoff_ || rootFixInd_.empty()) return 0;
+    globalFixCutoff_ = cutoff;
+
+    double gap = cutoff - rootLpValue_;
+    int size = static_cast<int>(rootFixInd_.size());
+
+    for (int k = 0; k < size; ++k) {
+        int j = rootFixInd_[k];
+        double movement = floor(gap / fabs(rootFixDj_[k]));
+        if (rootFixDj_[k] > 0.0) {
+            // At lower bound in the root lp.
+            if (tightenGlobalBounds(j, -ALPS_DBL_MAX,
+                                    rootFixBound_[k] + movement)) {
+                ++numChanged;
+            }
+        }
+        else {
+            if (tightenGlobalBounds(j, rootFixBound_[k] - movement,
+                                    ALPS_DBL_MAX)) {
+                ++numChanged;
+            }
+        }
+    }
+
+#ifdef BLIS_DEBUG
+    if (numChanged > 0) {
+        std::cout << "GLOBAL FIX: cutoff " << cutoff << " tightened "
+                  << numChanged << " bounds" << std::endl;
+    }
+#endif
+
+    return numChanged;
+}
+
+//############################################################################
+
+bool
+BlisModel::tightenGlobalBounds(int j, double lower, double upper)
+{
+    if (!globalVarLB_) {
+        globalVarLB_ = new double [numCols_];
+        globalVarUB_ = new double [numCols_];
+        CoinFillN(globalVarLB_, numCols_, -ALPS_DBL_MAX);
+        CoinFillN(globalVarUB_, numCols_, ALPS_DBL_MAX);
+        globalDirtyMark_.assign(numCols_, 0);
+    }
+
+    bool changed = false;
+    if (lower > globalVarLB_[j]) {
+        globalVarLB_[j] = lower;
+        changed = true;
+    }
+    if (upper < globalVarUB_[j]) {
+        globalVarUB_[j] = upper;
+        changed = true;
+    }
+    if (changed && !globalDirtyMark_[j]) {
+        globalDirtyMark_[j] = 1;
+        globalDirty_.push_back(j);
+    }
+    return changed;
+}
+
+//############################################################################
+
 bool
 BlisModel::setBestSolution(BLIS_SOL_TYPE how,
 			   double & objectiveValue,
@@ -638,6 +1729,7 @@ BlisModel::setBestSolution(BLIS_SOL_TYPE how,
 
         // Update cutoff value in lp solver.
 	setCutoff(incObjValue_);
+        prunePoolNodes(incObjValue_);
         ++numSolutions_;
 
 	switch (how) {
@@ -712,9 +1804,7 @@ BlisModel::findIntegers(bool startAgain)
     const double *colUB = lpSolver_->getColUpper();
     BlisObjectInt *intObject = NULL;
 
-    if (intVars_) {
-        delete [] intVars_;
-    }
+    freeCoreArray(intVars_);
     numIntVars_ = 0;
 
     for (iCol = 0; iCol < numCols; ++iCol) {
@@ -810,12 +1900,41 @@ BlisModel::gutsOfDestructor()
 {
     int i;
 
+    // Stop the heuristic thread before what it uses goes away.
+    delete heurWorker_;
+    heurWorker_ = NULL;
+
+    delete solPool_;
+    solPool_ = NULL;
+
+    // Core data in an image is not ours to delete, free the rest before
+    // the images go away.
+    freeColMatrix();
+    freeCoreArray(origVarLB_);
+    freeCoreArray(origVarUB_);
+    freeCoreArray(origConLB_);
+    freeCoreArray(origConUB_);
+    freeCoreArray(objCoef_);
+    freeCoreArray(colType_);
+    freeCoreArray(intVars_);
+    releaseCacheImage();
+
+    if (sharedImage_) {
+#ifdef BLIS_HAS_SHM
+        munmap(sharedImage_, sharedImageSize_);
+        if (!sharedImageName_.empty()) {
+            shm_unlink(sharedImageName_.c_str());
+        }
+#endif
+        sharedImage_ = NULL;
+    }
+
+    delete presolve_;
+    presolve_ = NULL;
+
 //    delete [] savedLpSolution_;
 //    savedLpSolution_ = NULL;
 
-    delete [] intVars_;
-    intVars_ = NULL;
-
     for (i = 0; i < numObjects_; ++i) delete objects_[i];
     delete [] objects_;
     objects_ = NULL;
@@ -823,14 +1942,7 @@ BlisModel::gutsOfDestructor()
     delete [] priority_;
     priority_ = NULL;
 
-    delete [] colType_;
-    delete colMatrix_;
-
-    delete [] origVarLB_;
-    delete [] origVarUB_;
-
-    delete [] origConLB_;
-    delete [] origConUB_;
+    delete rowMatrix_;
 
     delete [] startVarLB_;
     delete [] startVarUB_;
@@ -844,7 +1956,13 @@ BlisModel::gutsOfDestructor()
     delete [] tempConLBPos_;
     delete [] tempConUBPos_;
 
-    delete [] objCoef_;
+    delete [] colBoundInd_;
+    delete [] colBoundVal_;
+
+    if (spillFile_) {
+        fclose(spillFile_);
+    }
+
     delete [] incumbent_;
 
     if (numHeuristics_ > 0) {
@@ -880,6 +1998,9 @@ BlisModel::gutsOfDestructor()
     delete constraintPool_;
     delete [] oldConstraints_;
     delete branchStrategy_;
+    delete propagator_;
+    delete [] globalVarLB_;
+    delete [] globalVarUB_;
 
     delete BlisPar_;
 }
@@ -1237,6 +2358,27 @@ AlpsReturnStatus BlisModel::encode(AlpsEncoded * encoded) const
     encoded->writeRep(numIntVars_);
     encoded->writeRep(intVars_, numIntVars_);
 
+    //------------------------------------------------------
+    // Presolve information needed to map solutions back.
+    //------------------------------------------------------
+
+    int hasPresolve = presolve_ ? 1 : 0;
+    encoded->writeRep(hasPresolve);
+    if (presolve_) {
+        presolve_->encode(encoded);
+    }
+
+    //------------------------------------------------------
+    // Name of the shared memory image of the core data.
+    //------------------------------------------------------
+
+    if (BlisPar_->entry(BlisParams::sharedModel)) {
+        std::ostringstream shmName;
+        shmName << "/blis." << BlisProcessId() << "." << time(NULL);
+        int nameLen = static_cast<int>(shmName.str().size()) + 1;
+        encoded->writeRep(shmName.str().c_str(), nameLen);
+    }
+
     //------------------------------------------------------
     // Debug.
     //------------------------------------------------------
@@ -1413,6 +2555,41 @@ AlpsReturnStatus BlisModel::decodeToSelf(AlpsEncoded & encoded)
     std::cout << std::endl;
 #endif
 
+    //------------------------------------------------------
+    // The column matrix takes over the decoded arrays.
+    //------------------------------------------------------
+
+    int *colLength = new int [numCols_];
+    for (j = 0; j < numCols_; ++j) {
+        colLength[j] = colStart[j + 1] - colStart[j];
+    }
+    colMatrix_ = new CoinPackedMatrix();
+    colMatrix_->assignMatrix(true, numRows_, numCols_, numElems_,
+                             elementValue, index, colStart, colLength);
+
+    //------------------------------------------------------
+    // Presolve information.
+    //------------------------------------------------------
+
+    int hasPresolve;
+    encoded.readRep(hasPresolve);
+    if (hasPresolve) {
+        presolve_ = new BlisPresolve;
+        presolve_->decodeToSelf(encoded);
+    }
+
+    //------------------------------------------------------
+    // Share core data with ranks on the same host.
+    //------------------------------------------------------
+
+    if (BlisPar_->entry(BlisParams::sharedModel)) {
+        char *shmName = NULL;
+        int nameLen;
+        encoded.readRep(shmName, nameLen);
+        attachSharedModel(shmName);
+        delete [] shmName;
+    }
+
     //------------------------------------------------------
     // Check if lpSolver_ is declared in main.
     //------------------------------------------------------
@@ -1423,26 +2600,100 @@ AlpsReturnStatus BlisModel::decodeToSelf(AlpsEncoded & encoded)
     // Load data to lp solver.
     //------------------------------------------------------
 
-    lpSolver_->loadProblem(numCols, numRows,
-			   colStart, index, elementValue,
+    lpSolver_->loadProblem(*colMatrix_,
 			   origVarLB_, origVarUB_,
 			   objCoef_,
 			   origConLB_, origConUB_);
 
     lpSolver_->setObjSense(objSense_);
     lpSolver_->setInteger(intVars_, numIntVars_);
+    if (presolve_) {
+        lpSolver_->setDblParam(OsiObjOffset, -presolve_->getObjOffset());
+    }
 
-    //------------------------------------------------------
-    // Clean up.
-    //------------------------------------------------------
+    return status;
+}
+
+//#############################################################################
 
-    delete [] colStart;
-    colStart = NULL;
+/** Alps asks for the shared knowledge after each unit of work, so a better
+    cutoff leaves with the next exchange. It is only packed when it
+    improved on the one last packed or received. Only the global bounds
+    changed since the last pack are sent, bounds received from others are
+    passed on once. */
+AlpsEncoded*
+BlisModel::packSharedKnowlege()
+{
+    int j, k;
+    std::vector<int> ind;
+    std::vector<double> lower;
+    std::vector<double> upper;
+
+    for (k = 0; k < static_cast<int>(globalDirty_.size()); ++k) {
+        j = globalDirty_[k];
+        ind.push_back(j);
+        lower.push_back(globalVarLB_[j]);
+        upper.push_back(globalVarUB_[j]);
+        globalDirtyMark_[j] = 0;
+    }
+    globalDirty_.clear();
 
-    delete [] index;
-    index = NULL;
+    double cutoff = ALPS_OBJ_MAX;
+    if (cutoff_ < sharedCutoff_) {
+        cutoff = cutoff_;
+        sharedCutoff_ = cutoff_;
+    }
 
-    return status;
+    if (ind.empty() && cutoff >= ALPS_OBJ_MAX) return NULL;
+
+    AlpsEncoded *encoded = new AlpsEncoded(AlpsKnowledgeTypeModelGen);
+    int size = static_cast<int>(ind.size());
+    encoded->writeRep(cutoff);
+    encoded->writeRep(size);
+    if (size > 0) {
+        encoded->writeRep(&ind[0], size);
+        encoded->writeRep(&lower[0], size);
+        encoded->writeRep(&upper[0], size);
+    }
+
+    return encoded;
+}
+
+//#############################################################################
+
+void
+BlisModel::unpackSharedKnowledge(AlpsEncoded& encoded)
+{
+    int k, size;
+    double cutoff;
+    int *ind = NULL;
+    double *lower = NULL;
+    double *upper = NULL;
+
+    encoded.readRep(cutoff);
+    encoded.readRep(size);
+    if (size > 0) {
+        encoded.readRep(ind, size);
+        encoded.readRep(lower, size);
+        encoded.readRep(upper, size);
+    }
+
+    // A better cutoff stops the lp and fathoms dominated pool nodes right
+    // away, and gives root reduced cost fixing a smaller gap.
+    if (cutoff < sharedCutoff_) {
+        sharedCutoff_ = cutoff;
+    }
+    if (tightenCutoff(cutoff)) {
+        updateGlobalBounds(cutoff);
+    }
+
+    for (k = 0; k < size; ++k) {
+        tightenGlobalBounds(ind[k], lower[k], upper[k]);
+    }
+
+    delete [] ind;
+    delete [] lower;
+    delete [] upper;
 }
 
 //#############################################################################
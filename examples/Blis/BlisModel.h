@@ -24,6 +24,9 @@
 #ifndef BlisModel_h_
 #define BlisModel_h_
 
+#include <cstdio>
+#include <map>
+
 #include "CoinMpsIO.hpp"
 #include "CoinPackedMatrix.hpp"
 #include "CoinMessageHandler.hpp"
@@ -49,14 +52,21 @@
 #include "AlpsTreeNode.h"
 
 class BlisConstraint;
+class BlisHeurWorker;
+class BlisPresolve;
+class BlisPropagator;
+class BlisSolutionPool;
+class BlisTreeNode;
 
 class BlisModel : public BcpsModel {
   /** Lp solver. */
   OsiSolverInterface *lpSolver_;
   ///@name Problem Data
   //@{
-  /// Orignial column majored matrix.(For MPS file, etc.)
+  /// Core matrix by column and by row. Complete after setupSelf and not
+  /// modified afterwards; shared by heuristics, propagation and setup.
   CoinPackedMatrix *colMatrix_;
+  CoinPackedMatrix *rowMatrix_;
   /// Original variable and constraint bounds.
   double *origVarLB_;
   double *origVarUB_;
@@ -74,6 +84,18 @@ class BlisModel : public BcpsModel {
   int numIntVars_;
   int *intVars_;
   char *colType_;
+  /// Mapped instance cache the core matrix and arrays point into when
+  /// the instance was read from it, NULL otherwise.
+  char *cacheImage_;
+  size_t cacheImageSize_;
+  /// Shared memory image holding the bounds, objective and column types
+  /// when Blis_sharedModel is set, NULL otherwise.
+  void *sharedImage_;
+  size_t sharedImageSize_;
+  /// Name of the segment if this rank created it and removes it.
+  std::string sharedImageName_;
+  /// Root presolve, NULL if the core problem is the original one.
+  BlisPresolve *presolve_;
   //@}
 
   ///@name Solution related
@@ -102,6 +124,37 @@ class BlisModel : public BcpsModel {
   /// Variable selection function.
   BcpsBranchStrategy * branchStrategy_;
 
+  /// Domain propagation over the core rows, NULL if disabled.
+  BlisPropagator *propagator_;
+
+  /// Integer columns at a bound in the root lp solution, their bound
+  /// and reduced cost (positive at lower, negative at upper bound).
+  std::vector<int> rootFixInd_;
+  std::vector<double> rootFixBound_;
+  std::vector<double> rootFixDj_;
+  double rootLpValue_;
+  /// Cutoff the global bounds were last computed with.
+  double globalFixCutoff_;
+  /// Global column bounds from root reduced cost fixing, NULL if none.
+  double *globalVarLB_;
+  double *globalVarUB_;
+  /// Columns whose global bounds changed since they were last packed for
+  /// other processes, and a mark for each column in the list.
+  std::vector<int> globalDirty_;
+  std::vector<char> globalDirtyMark_;
+
+  /// Nodes waiting in the node pool and the bytes counted for their
+  /// descriptions, only what stays in memory if spilled.
+  std::map<BlisTreeNode *, size_t> poolNodes_;
+  /// Bytes of the pool node descriptions in memory.
+  size_t poolMemory_;
+  /// Number of pool node descriptions in the spill file.
+  int numSpilled_;
+  /// Append-only file node descriptions are spilled to, NULL until needed.
+  FILE *spillFile_;
+  /// Cutoff last packed for or received from other processes.
+  double sharedCutoff_;
+
   // Hotstart strategy 0 = off,
   // 1 = branch if incorrect,
   // 2 = branch even if correct, ....
@@ -135,6 +188,12 @@ class BlisModel : public BcpsModel {
   int numHeuristics_;
   /** The list of heuristics. */
   BlisHeuristic ** heuristics_;
+  /** Thread running heuristic clones on node lp snapshots, NULL if the
+      heuristics run in the node loop. */
+  BlisHeurWorker *heurWorker_;
+  /** Solutions found in this process, to drop duplicates and keep the
+      best ones for guided heuristics. */
+  BlisSolutionPool *solPool_;
   //@}
 
   ///@name Constraints
@@ -187,6 +246,9 @@ class BlisModel : public BcpsModel {
   int *tempVarUBPos_;
   int *tempConLBPos_;
   int *tempConUBPos_;
+  /// Index and (lower, upper) pairs of a bulk column bound update.
+  int *colBoundInd_;
+  double *colBoundVal_;
   //@}
 
 public:
@@ -227,6 +289,47 @@ public:
   /** Read in the instance data */
   virtual void readInstance(const char* dataFile);
 
+  /** Read in the instance data from an MPS file. */
+  void readMpsInstance(const char* dataFile);
+
+  /** Load the instance data from a binary cache of dataFile. The cache
+      stays mapped and the core matrix and arrays point into it, nothing
+      is copied. Return false if the cache does not exist or does not
+      match dataFile. */
+  bool readInstanceCache(const char *dataFile, const char *cacheFile);
+
+  /** Write the instance data to a binary cache of dataFile, which
+      readInstanceCache maps into memory instead of parsing dataFile. */
+  void writeInstanceCache(const char *dataFile, const char *cacheFile) const;
+
+  /** Return true if p points into the instance cache or the shared image,
+      which own that memory. */
+  bool isImageData(const void *p) const;
+
+  /** Free a core array unless it lies in an image, and set it to NULL. */
+  template <class T> void freeCoreArray(T *&array) {
+      if (!isImageData(array)) {
+          delete [] array;
+      }
+      array = NULL;
+  }
+
+  /** Delete the core matrix. Arrays it borrows from an image are
+      released first, not freed. */
+  void freeColMatrix();
+
+  /** Unmap the instance cache once nothing points into it any more. */
+  void releaseCacheImage();
+
+  /** Move the decoded bounds, objective and column types into a read-only
+      POSIX shared memory image used by all ranks on this host. Return
+      false if it can not be used. */
+  bool attachSharedModel(const char *name);
+
+  /** Reduce the core problem in place with BlisPresolve. The reduction
+      is kept in presolve_ to map solutions back. */
+  void presolveInstance();
+
   /** Read in Alps, Blis parameters. */
   virtual void readParameters(const int argnum, const char * const *arglist);
 
@@ -301,6 +404,33 @@ public:
   int *tempConLBPos() { return tempConLBPos_; }
   int *tempConUBPos() { return tempConUBPos_; }
 
+  /** Set the lp column bounds to lower and upper with one bulk call that
+      only includes the columns whose bounds differ. Return the number of
+      columns changed. */
+  int installColBounds(const double *lower, const double *upper);
+
+  /** Track a node entering the node pool. Its description is counted
+      against the node memory limit, if there is one. */
+  void addPoolNode(BlisTreeNode *node);
+
+  /** Stop counting a node leaving the node pool. If restore is true, its
+      description is read back when it was spilled. */
+  void removePoolNode(BlisTreeNode *node, bool restore = true);
+
+  /** Read back the description of a pool node if it was spilled. */
+  void restorePoolNode(BlisTreeNode *node);
+
+  /** Spill the descriptions of the worst pool nodes while the pool is
+      over the node memory limit. */
+  void checkPoolMemory();
+
+  /** Fathom the pool nodes that can not improve on cutoff (minimization
+      form) by the optimality gap. Return the number fathomed. */
+  int prunePoolNodes(double cutoff);
+
+  /** Bytes of the pool node descriptions in memory. */
+  size_t getPoolMemory() const { return poolMemory_; }
+
   //------------------------------------------------------
   // LP SOLUTION
   //------------------------------------------------------
@@ -343,11 +473,27 @@ public:
     cutoff_ = co;
   }
 
+  /** Lower the cutoff to value (minimization form) if that is better,
+      and fathom the pool nodes it dominates. Return true if the cutoff
+      changed. */
+  inline bool tightenCutoff(double value) {
+    if (value < ALPS_OBJ_MAX && value < cutoff_) {
+      setCutoff(value);
+      prunePoolNodes(value);
+      return true;
+    }
+    return false;
+  }
+
   /** Test the current lp solution for feasiblility.
       Scan integer objects for indications of infeasibility.
   */
   BlisSolution * feasibleSolution(int & numIntegerInfs, double & infAmount);
 
+  /** Create a solution of the original problem from a solution x of the
+      core problem with value objValue. */
+  BlisSolution * createSolution(const double *x, double objValue) const;
+
   /** Test the current solution for feasiblility.
       Scan all objects for indications of infeasibility. This is broken down
       into simple integer infeasibility (\p numIntegerInfs)
@@ -380,6 +526,28 @@ public:
   }
   //@}
 
+  /** Get the domain propagator, NULL if disabled. */
+  BlisPropagator * propagator() { return propagator_; }
+
+  /** Keep reduced costs of the integer columns at a bound in the root lp
+      solution, so later incumbents can fix columns globally. */
+  void setRootReducedCosts(const double *solution,
+                           const double *reducedCost,
+                           const double *lower,
+                           const double *upper,
+                           double lpValue);
+
+  /** Tighten the global bounds by root reduced cost fixing with the given
+      cutoff. Return the number of bounds changed. */
+  int updateGlobalBounds(double cutoff);
+
+  /** Tighten the global bounds of column j. Return true if changed. */
+  bool tightenGlobalBounds(int j, double lower, double upper);
+
+  /** Global column bounds valid at every node, NULL if none. */
+  const double * globalVarLB() const { return globalVarLB_; }
+  const double * globalVarUB() const { return globalVarUB_; }
+
   /** \name Object manipulation routines
    */
   //@{
@@ -437,6 +605,18 @@ public:
   /** Get the number of heuristics. */
   int numHeuristics() const { return numHeuristics_; }
 
+  /** Get the core matrix by column. Valid after setupSelf. */
+  const CoinPackedMatrix & getColMatrix() const { return *colMatrix_; }
+
+  /** Get the core matrix by row. Valid after setupSelf. */
+  const CoinPackedMatrix & getRowMatrix() const { return *rowMatrix_; }
+
+  /** Get the heuristic thread, NULL if not used. */
+  BlisHeurWorker * heurWorker() { return heurWorker_; }
+
+  /** Get the solution pool. Valid after setupSelf. */
+  BlisSolutionPool * solutionPool() { return solPool_; }
+
   //------------------------------------------------------
   // CONSTRAINTS.
   //------------------------------------------------------
@@ -563,7 +743,9 @@ public:
   /** Increment Iteration count. */
   void addNumIterations(int newIter) {
     numIterations_ += newIter;
-    aveIterations_ = numIterations_ / numNodes_;
+    if (numNodes_ > 0) {
+      aveIterations_ = numIterations_ / numNodes_;
+    }
   }
 
   /** Get the message handler. */
@@ -585,6 +767,14 @@ public:
   /** Register knowledge. */
   virtual void registerKnowledge();
 
+  /** Pack the cutoff, when it improved since it was last shared, and the
+      global bounds to share them with other processes. Return NULL if
+      there is nothing to share. */
+  virtual AlpsEncoded* packSharedKnowlege();
+
+  /** Apply the cutoff and global bounds packed by another process. */
+  virtual void unpackSharedKnowledge(AlpsEncoded& encoded);
+
   using AlpsKnowledge::encode;
   virtual AlpsReturnStatus encode(AlpsEncoded * encoded) const;
   virtual AlpsKnowledge * decode(AlpsEncoded & encoded) const;
@@ -0,0 +1,621 @@
+/*===========================================================================*
+ * This file is part of the Bcps Linear Solver (BLIS).                       *
+ *                                                                           *
+ * BLIS is distributed under the Eclipse Public License as part of the       *
+ * COIN-OR repository (http://www.coin-or.org).                              *
+ *                                                                           *
+ * Authors:                                                                  *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *                                                                           *
+ * Conceptual Design:                                                        *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *          Laszlo Ladanyi, IBM T.J. Watson Research Center                  *
+ *          Matthew Saltzman, Clemson University                             *
+ *                                                                           *
+ *                                                                           *
+ * Copyright (C) 2001-2017, Lehigh University, Yan Xu, and Ted Ralphs.       *
+ * All Rights Reserved.                                                      *
+ *===========================================================================*/
+
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "CoinError.hpp"
+#include "CoinFileIO.hpp"
+#include "CoinFinite.hpp"
+#include "CoinHelperFunctions.hpp"
+
+#include "BlisMpsReader.h"
+
+//#############################################################################
+
+/** Number of bytes read from the file at a time. */
+static const int BLIS_MPS_CHUNK = 1 << 20;
+
+/** Max number of fields on a line. */
+static const int BLIS_MPS_MAX_TOKENS = 8;
+
+/** Values at least this large are infinite. */
+static const double BLIS_MPS_INFINITY = 1.0e30;
+
+/** Reallocate array from oldSize to newSize entries, keeping contents. */
+template <class T> static void
+BlisGrowArray(T *&array, CoinBigIndex oldSize, CoinBigIndex newSize)
+{
+    T *temp = new T [newSize];
+    if (oldSize > 0) {
+        memcpy(temp, array, sizeof(T) * oldSize);
+    }
+    delete [] array;
+    array = temp;
+}
+
+//#############################################################################
+
+BlisMpsReader::BlisMpsReader()
+    :
+    section_(secNone),
+    lineNumber_(0),
+    numRows_(0),
+    haveObjective_(false),
+    numCols_(0),
+    maxCols_(0),
+    intMarker_(false),
+    numElems_(0),
+    maxElems_(0),
+    elements_(NULL),
+    indices_(NULL),
+    starts_(NULL),
+    lengths_(NULL),
+    colLower_(NULL),
+    colUpper_(NULL),
+    objective_(NULL),
+    isInteger_(NULL)
+{}
+
+//#############################################################################
+
+void
+BlisMpsReader::gutsOfDestructor()
+{
+    delete [] elements_;
+    elements_ = NULL;
+    delete [] indices_;
+    indices_ = NULL;
+    delete [] starts_;
+    starts_ = NULL;
+    delete [] lengths_;
+    lengths_ = NULL;
+    delete [] colLower_;
+    colLower_ = NULL;
+    delete [] colUpper_;
+    colUpper_ = NULL;
+    delete [] objective_;
+    objective_ = NULL;
+    delete [] isInteger_;
+    isInteger_ = NULL;
+}
+
+//#############################################################################
+
+int
+BlisMpsReader::readMps(const char *fileName)
+{
+    CoinFileInput *input = NULL;
+    try {
+        input = CoinFileInput::create(fileName);
+    }
+    catch (CoinError &) {
+        return -1;
+    }
+
+    int status = 0;
+    int bufSize = BLIS_MPS_CHUNK;
+    int carry = 0;   // Bytes of an unfinished line from the last chunk.
+    char *buffer = new char [bufSize + 1];
+
+    while (status == 0 && section_ != secEnd) {
+        int numRead = input->read(buffer + carry, bufSize - carry);
+        if (numRead <= 0) {
+            // End of file, the rest is the last line.
+            if (carry > 0) {
+                buffer[carry] = '\0';
+                ++lineNumber_;
+                status = parseLine(buffer);
+            }
+            break;
+        }
+
+        char *begin = buffer;
+        char *end = buffer + carry + numRead;
+        char *newLine;
+        while ((newLine = static_cast<char *>
+                (memchr(begin, '\n', end - begin))) != NULL) {
+            *newLine = '\0';
+            ++lineNumber_;
+            status = parseLine(begin);
+            begin = newLine + 1;
+            if (status || section_ == secEnd) break;
+        }
+
+        carry = static_cast<int>(end - begin);
+        if (carry == bufSize) {
+            // Line longer than the buffer.
+            BlisGrowArray(buffer, bufSize, 2 * bufSize + 1);
+            bufSize *= 2;
+        }
+        else if (carry > 0) {
+            memmove(buffer, begin, carry);
+        }
+    }
+
+    delete [] buffer;
+    delete input;
+
+    if (status == 0 && (section_ != secEnd || numCols_ == 0)) {
+        status = 1;
+    }
+
+    if (status) {
+        std::cout << "BlisMpsReader: can not read " << fileName
+                  << " (line " << lineNumber_ << ")" << std::endl;
+    }
+
+    return status;
+}
+
+//#############################################################################
+
+int
+BlisMpsReader::parseLine(char *line)
+{
+    if (line[0] == '*' || line[0] == '\0') {
+        // Comment or empty line.
+        return 0;
+    }
+
+    bool header = !isspace(static_cast<unsigned char>(line[0]));
+
+    char *token[BLIS_MPS_MAX_TOKENS];
+    int numTokens = 0;
+    char *p = line;
+    while (*p) {
+        while (*p && isspace(static_cast<unsigned char>(*p))) ++p;
+        if (*p == '\0') break;
+        if (numTokens == BLIS_MPS_MAX_TOKENS) {
+            return 1;
+        }
+        token[numTokens++] = p;
+        while (*p && !isspace(static_cast<unsigned char>(*p))) ++p;
+        if (*p) *p++ = '\0';
+    }
+
+    if (numTokens == 0) {
+        return 0;
+    }
+
+    if (header) {
+        return parseSection(token, numTokens);
+    }
+
+    switch (section_) {
+    case secName:
+        // Nothing expected here.
+        return 1;
+    case secRows:
+        return parseRow(token, numTokens);
+    case secColumns:
+        return parseColumn(token, numTokens);
+    case secRhs:
+        return parseRhs(token, numTokens, false);
+    case secRanges:
+        return parseRhs(token, numTokens, true);
+    case secBounds:
+        return parseBound(token, numTokens);
+    default:
+        return 1;
+    }
+}
+
+//#############################################################################
+
+int
+BlisMpsReader::parseSection(char **token, int numTokens)
+{
+    const char *key = token[0];
+
+    if (strcmp(key, "NAME") == 0) {
+        section_ = secName;
+    }
+    else if (strcmp(key, "ROWS") == 0) {
+        section_ = secRows;
+    }
+    else if (strcmp(key, "COLUMNS") == 0) {
+        section_ = secColumns;
+    }
+    else if (strcmp(key, "RHS") == 0) {
+        section_ = secRhs;
+    }
+    else if (strcmp(key, "RANGES") == 0) {
+        section_ = secRanges;
+    }
+    else if (strcmp(key, "BOUNDS") == 0) {
+        section_ = secBounds;
+    }
+    else if (strcmp(key, "ENDATA") == 0) {
+        section_ = secEnd;
+    }
+    else {
+        // OBJSENSE, SOS, QUADOBJ, ... are left to CoinMpsIO.
+        return 1;
+    }
+
+    return 0;
+}
+
+//#############################################################################
+
+int
+BlisMpsReader::parseRow(char **token, int numTokens)
+{
+    if (numTokens != 2) {
+        return 1;
+    }
+
+    char type = static_cast<char>(toupper(token[0][0]));
+    std::string name(token[1]);
+
+    if (token[0][1] != '\0' || rowIndex_.count(name)) {
+        return 1;
+    }
+
+    switch (type) {
+    case 'N':
+        // The first free row is the objective, others are dropped.
+        rowIndex_[name] = haveObjective_ ? -2 : -1;
+        haveObjective_ = true;
+        break;
+    case 'E':
+    case 'L':
+    case 'G':
+        rowIndex_[name] = numRows_++;
+        rowType_.push_back(type);
+        rhs_.push_back(0.0);
+        range_.push_back(COIN_DBL_MAX);
+        break;
+    default:
+        return 1;
+    }
+
+    return 0;
+}
+
+//#############################################################################
+
+int
+BlisMpsReader::addColumn(const char *name)
+{
+    std::string colName(name);
+    if (colIndex_.count(colName)) {
+        // Column entries are not contiguous.
+        return 1;
+    }
+
+    if (numCols_ == maxCols_) {
+        int newMax = CoinMax(2 * maxCols_, 1024);
+        BlisGrowArray(starts_, maxCols_ + 1, newMax + 1);
+        BlisGrowArray(lengths_, maxCols_, newMax);
+        BlisGrowArray(colLower_, maxCols_, newMax);
+        BlisGrowArray(colUpper_, maxCols_, newMax);
+        BlisGrowArray(objective_, maxCols_, newMax);
+        BlisGrowArray(isInteger_, maxCols_, newMax);
+        if (maxCols_ == 0) {
+            starts_[0] = 0;
+        }
+        maxCols_ = newMax;
+    }
+
+    colIndex_[colName] = numCols_;
+    currentCol_ = colName;
+
+    lengths_[numCols_] = 0;
+    colLower_[numCols_] = 0.0;
+    // Integer columns between markers are binary unless BOUNDS says
+    // otherwise, as in CoinMpsIO.
+    colUpper_[numCols_] = intMarker_ ? 1.0 : COIN_DBL_MAX;
+    objective_[numCols_] = 0.0;
+    isInteger_[numCols_] = intMarker_ ? 1 : 0;
+    ++numCols_;
+    starts_[numCols_] = numElems_;
+
+    return 0;
+}
+
+//#############################################################################
+
+int
+BlisMpsReader::parseColumn(char **token, int numTokens)
+{
+    if (numTokens >= 3 && strcmp(token[1], "'MARKER'") == 0) {
+        if (strcmp(token[2], "'INTORG'") == 0) {
+            intMarker_ = true;
+        }
+        else if (strcmp(token[2], "'INTEND'") == 0) {
+            intMarker_ = false;
+        }
+        else {
+            return 1;
+        }
+        return 0;
+    }
+
+    if (numTokens != 3 && numTokens != 5) {
+        return 1;
+    }
+
+    if (numCols_ == 0 || currentCol_ != token[0]) {
+        if (addColumn(token[0])) {
+            return 1;
+        }
+    }
+
+    int col = numCols_ - 1;
+
+    for (int k = 1; k < numTokens; k += 2) {
+        std::map<std::string, int>::const_iterator pos =
+            rowIndex_.find(token[k]);
+        double value;
+        if (pos == rowIndex_.end() || !toDouble(token[k + 1], value)) {
+            return 1;
+        }
+
+        int row = pos->second;
+        if (row == -1) {
+            objective_[col] = value;
+        }
+        else if (row >= 0 && value != 0.0) {
+            if (numElems_ == maxElems_) {
+                CoinBigIndex newMax = CoinMax(2 * maxElems_,
+                                              static_cast<CoinBigIndex>(4096));
+                BlisGrowArray(elements_, maxElems_, newMax);
+                BlisGrowArray(indices_, maxElems_, newMax);
+                maxElems_ = newMax;
+            }
+            elements_[numElems_] = value;
+            indices_[numElems_] = row;
+            ++numElems_;
+            ++lengths_[col];
+            starts_[numCols_] = numElems_;
+        }
+    }
+
+    return 0;
+}
+
+//#############################################################################
+
+int
+BlisMpsReader::parseRhs(char **token, int numTokens, bool isRange)
+{
+    if (numTokens < 2 || numTokens > 5) {
+        return 1;
+    }
+
+    // The set name is optional.
+    int first = numTokens % 2;
+
+    for (int k = first; k < numTokens; k += 2) {
+        std::map<std::string, int>::const_iterator pos =
+            rowIndex_.find(token[k]);
+        double value;
+        if (pos == rowIndex_.end() || !toDouble(token[k + 1], value)) {
+            return 1;
+        }
+
+        int row = pos->second;
+        if (row < 0) {
+            // NOTE: the objective constant is not kept.
+            continue;
+        }
+        if (isRange) {
+            range_[row] = value;
+        }
+        else {
+            rhs_[row] = value;
+        }
+    }
+
+    return 0;
+}
+
+//#############################################################################
+
+int
+BlisMpsReader::parseBound(char **token, int numTokens)
+{
+    const char *type = token[0];
+    bool hasValue = (strcmp(type, "UP") == 0 ||
+                     strcmp(type, "LO") == 0 ||
+                     strcmp(type, "FX") == 0 ||
+                     strcmp(type, "LI") == 0 ||
+                     strcmp(type, "UI") == 0);
+
+    const char *name = NULL;
+    double value = 0.0;
+
+    if (hasValue) {
+        if (numTokens < 3 || numTokens > 4 ||
+            !toDouble(token[numTokens - 1], value)) {
+            return 1;
+        }
+        name = token[numTokens - 2];
+    }
+    else {
+        // The set name is optional, BV may be followed by a value.
+        if (numTokens == 2) {
+            name = token[1];
+        }
+        else if (numTokens == 3 || numTokens == 4) {
+            name = token[2];
+        }
+        else {
+            return 1;
+        }
+    }
+
+    std::map<std::string, int>::const_iterator pos = colIndex_.find(name);
+    if (pos == colIndex_.end()) {
+        return 1;
+    }
+
+    int col = pos->second;
+
+    if (strcmp(type, "UP") == 0) {
+        colUpper_[col] = value;
+        if (value < 0.0 && colLower_[col] == 0.0) {
+            colLower_[col] = -COIN_DBL_MAX;
+        }
+    }
+    else if (strcmp(type, "LO") == 0) {
+        colLower_[col] = value;
+    }
+    else if (strcmp(type, "FX") == 0) {
+        colLower_[col] = value;
+        colUpper_[col] = value;
+    }
+    else if (strcmp(type, "LI") == 0) {
+        colLower_[col] = value;
+        isInteger_[col] = 1;
+    }
+    else if (strcmp(type, "UI") == 0) {
+        colUpper_[col] = value;
+        isInteger_[col] = 1;
+    }
+    else if (strcmp(type, "FR") == 0) {
+        colLower_[col] = -COIN_DBL_MAX;
+        colUpper_[col] = COIN_DBL_MAX;
+    }
+    else if (strcmp(type, "MI") == 0) {
+        colLower_[col] = -COIN_DBL_MAX;
+    }
+    else if (strcmp(type, "PL") == 0) {
+        colUpper_[col] = COIN_DBL_MAX;
+    }
+    else if (strcmp(type, "BV") == 0) {
+        colLower_[col] = 0.0;
+        colUpper_[col] = 1.0;
+        isInteger_[col] = 1;
+    }
+    else {
+        // SC and unknown types.
+        return 1;
+    }
+
+    return 0;
+}
+
+//#############################################################################
+
+bool
+BlisMpsReader::toDouble(const char *token, double &value) const
+{
+    char *end;
+    value = strtod(token, &end);
+    if (end == token || *end != '\0') {
+        return false;
+    }
+    if (value >= BLIS_MPS_INFINITY) {
+        value = COIN_DBL_MAX;
+    }
+    else if (value <= -BLIS_MPS_INFINITY) {
+        value = -COIN_DBL_MAX;
+    }
+    return true;
+}
+
+//#############################################################################
+
+void
+BlisMpsReader::getRowBounds(double *&rowLower, double *&rowUpper) const
+{
+    rowLower = new double [numRows_];
+    rowUpper = new double [numRows_];
+
+    for (int i = 0; i < numRows_; ++i) {
+        double rhs = rhs_[i];
+        double range = range_[i];
+        bool hasRange = (range != COIN_DBL_MAX);
+        switch (rowType_[i]) {
+        case 'E':
+            rowLower[i] = rhs;
+            rowUpper[i] = rhs;
+            if (hasRange && range > 0.0) {
+                rowUpper[i] = rhs + range;
+            }
+            else if (hasRange) {
+                rowLower[i] = rhs + range;
+            }
+            break;
+        case 'L':
+            rowLower[i] = hasRange ? rhs - fabs(range) : -COIN_DBL_MAX;
+            rowUpper[i] = rhs;
+            break;
+        default:
+            rowLower[i] = rhs;
+            rowUpper[i] = hasRange ? rhs + fabs(range) : COIN_DBL_MAX;
+            break;
+        }
+    }
+}
+
+//#############################################################################
+
+CoinPackedMatrix *
+BlisMpsReader::releaseMatrix()
+{
+    CoinPackedMatrix *matrix = new CoinPackedMatrix();
+    // Takes over the arrays and sets the pointers to NULL.
+    matrix->assignMatrix(true, numRows_, numCols_, numElems_,
+                         elements_, indices_, starts_, lengths_,
+                         maxCols_, maxElems_);
+    return matrix;
+}
+
+//#############################################################################
+
+double *
+BlisMpsReader::releaseColLower()
+{
+    double *temp = colLower_;
+    colLower_ = NULL;
+    return temp;
+}
+
+//#############################################################################
+
+double *
+BlisMpsReader::releaseColUpper()
+{
+    double *temp = colUpper_;
+    colUpper_ = NULL;
+    return temp;
+}
+
+//#############################################################################
+
+double *
+BlisMpsReader::releaseObjective()
+{
+    double *temp = objective_;
+    objective_ = NULL;
+    return temp;
+}
+
+//#############################################################################
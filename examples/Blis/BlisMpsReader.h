@@ -0,0 +1,170 @@
+/*===========================================================================*
+ * This file is part of the Bcps Linear Solver (BLIS).                       *
+ *                                                                           *
+ * BLIS is distributed under the Eclipse Public License as part of the       *
+ * COIN-OR repository (http://www.coin-or.org).                              *
+ *                                                                           *
+ * Authors:                                                                  *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *                                                                           *
+ * Conceptual Design:                                                        *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *          Laszlo Ladanyi, IBM T.J. Watson Research Center                  *
+ *          Matthew Saltzman, Clemson University                             *
+ *                                                                           *
+ *                                                                           *
+ * Copyright (C) 2001-2017, Lehigh University, Yan Xu, and Ted Ralphs.       *
+ * All Rights Reserved.                                                      *
+ *===========================================================================*/
+
+#ifndef BlisMpsReader_h_
+#define BlisMpsReader_h_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "CoinPackedMatrix.hpp"
+
+class CoinFileInput;
+
+//#############################################################################
+
+/** Streaming MPS reader.
+    Reads free or fixed MPS files whose names contain no blanks, plain or
+    compressed (whatever CoinFileInput supports), in fixed size chunks.
+    Since COLUMNS lists the matrix column by column, the column-major
+    matrix is built in place and handed over to the caller without
+    copying. Files using sections other than NAME, ROWS, COLUMNS, RHS,
+    RANGES, BOUNDS and ENDATA, or semi-continuous bounds, are rejected so
+    that the caller can fall back to CoinMpsIO. Integer columns between
+    INTORG/INTEND markers get upper bound 1.0 if BOUNDS has none for them.
+
+    Parsing is sequential. The input is a stream that may be compressed,
+    so it can not be split at arbitrary offsets without decompressing it
+    first, and the matrix can only be built in place because COLUMNS
+    comes in column order. A parallel parse would have to buffer the
+    whole file and merge per thread arrays and name maps, which gives up
+    the memory saving the reader exists for.
+*/
+class BlisMpsReader {
+ private:
+    /** Current section of the file. */
+    enum Section {
+        secNone = 0,
+        secName,
+        secRows,
+        secColumns,
+        secRhs,
+        secRanges,
+        secBounds,
+        secEnd
+    };
+
+    /** Illegal copy constructor. */
+    BlisMpsReader(const BlisMpsReader &);
+
+    /** Illegal assignment operator. */
+    BlisMpsReader & operator=(const BlisMpsReader &);
+
+    /** Section being read. */
+    Section section_;
+    /** Current line number, for messages. */
+    int lineNumber_;
+
+    /** Number of rows, objective excluded. */
+    int numRows_;
+    /** Row type (E, L, G) by row index. */
+    std::vector<char> rowType_;
+    /** Right hand side and range by row index. A range of COIN_DBL_MAX
+        means no range was given. */
+    std::vector<double> rhs_;
+    std::vector<double> range_;
+    /** Row index by name. The objective maps to -1, other free rows to
+        -2 and are dropped. */
+    std::map<std::string, int> rowIndex_;
+    /** Whether an objective row has been seen. */
+    bool haveObjective_;
+
+    /** Number of columns. */
+    int numCols_;
+    /** Size of column arrays. */
+    int maxCols_;
+    /** Column index by name. */
+    std::map<std::string, int> colIndex_;
+    /** Name of the column being read in COLUMNS. */
+    std::string currentCol_;
+    /** Whether inside an INTORG/INTEND marker pair. */
+    bool intMarker_;
+
+    /** Column-major matrix being built. */
+    CoinBigIndex numElems_;
+    CoinBigIndex maxElems_;
+    double *elements_;
+    int *indices_;
+    CoinBigIndex *starts_;
+    int *lengths_;
+
+    /** Column data. */
+    double *colLower_;
+    double *colUpper_;
+    double *objective_;
+    char *isInteger_;
+
+    /** Parse one line, return 0 if fine. */
+    int parseLine(char *line);
+
+    /** Handle a section header line. */
+    int parseSection(char **token, int numTokens);
+
+    /** Handle data lines of each section. */
+    int parseRow(char **token, int numTokens);
+    int parseColumn(char **token, int numTokens);
+    int parseRhs(char **token, int numTokens, bool isRange);
+    int parseBound(char **token, int numTokens);
+
+    /** Append a column named name, return 0 if fine. */
+    int addColumn(const char *name);
+
+    /** Convert a token to a number, return false if it is not one. */
+    bool toDouble(const char *token, double &value) const;
+
+    /** Free all data. */
+    void gutsOfDestructor();
+
+ public:
+    /** Default constructor. */
+    BlisMpsReader();
+
+    /** Destructor. */
+    ~BlisMpsReader() { gutsOfDestructor(); }
+
+    /** Read an MPS file. Return 0 on success, -1 if the file could not be
+        opened and 1 if the file uses a feature not supported here or has
+        an error. */
+    int readMps(const char *fileName);
+
+    /** Get problem size. */
+    int getNumCols() const { return numCols_; }
+    int getNumRows() const { return numRows_; }
+    CoinBigIndex getNumElements() const { return numElems_; }
+
+    /** Return true if column j is integer. */
+    bool isInteger(int j) const { return isInteger_[j] != 0; }
+
+    /** Release problem data, the caller owns it afterward. */
+    CoinPackedMatrix *releaseMatrix();
+    double *releaseColLower();
+    double *releaseColUpper();
+    double *releaseObjective();
+
+    /** Create row bounds from row types, right hand sides and ranges.
+        The caller owns them. */
+    void getRowBounds(double *&rowLower, double *&rowUpper) const;
+};
+
+#endif
@@ -26,16 +26,204 @@
 
 //#############################################################################
 
+#include <exception>
+#include <iostream>
+
 #include "CoinWarmStartBasis.hpp"
 
 #include "AlpsNodeDesc.h"
 #include "BcpsNodeDesc.h"
 
+#include "BlisConstraint.h"
 #include "BlisHelp.h"
 #include "BlisModel.h"
 
 //#############################################################################
 
+/** Explicit hard variable bounds shared by the node descriptions created
+    during ramp-up. A node refers to the block and stores its own changes in
+    the hard bound lists. The block is reference counted and is not modified
+    once it is shared. */
+class BlisSharedBounds {
+
+ private:
+
+    /** Number of node descriptions refering to this. */
+    int refCount_;
+
+    /** Number of variables. */
+    int size_;
+
+    /** Lower and upper bounds, indexed by variable. */
+    double *lower_;
+    double *upper_;
+
+    /** Deleted by release() only. */
+    ~BlisSharedBounds() {
+        delete [] lower_;
+        delete [] upper_;
+    }
+
+    /** No copy constructor, assignment operator. */
+    BlisSharedBounds(const BlisSharedBounds&);
+    BlisSharedBounds& operator=(const BlisSharedBounds&);
+
+ public:
+
+    /** Useful constructor. Take over the memory ownship of lb and ub. */
+    BlisSharedBounds(int size, double *&lb, double *&ub)
+        :
+        refCount_(1),
+        size_(size),
+        lower_(lb),
+        upper_(ub)
+        {
+            lb = NULL;
+            ub = NULL;
+        }
+
+    /** Add a reference and return this. */
+    BlisSharedBounds * share() { ++refCount_; return this; }
+
+    /** Remove a reference, free memory when it is the last one. */
+    void release() {
+        if (--refCount_ == 0) {
+            delete this;
+        }
+    }
+
+    /** Get number of variables. */
+    int getSize() const { return size_; }
+
+    /** Get lower bounds. */
+    const double * getLower() const { return lower_; }
+
+    /** Get upper bounds. */
+    const double * getUpper() const { return upper_; }
+};
+
+//#############################################################################
+
+/** Warm start basis shared by node descriptions. A basis is stored either
+    in full or as the difference from the basis it was reached from. It is
+    reference counted and is not modified once created, so siblings can
+    safely share it. */
+class BlisSharedBasis {
+
+ private:
+
+    /** Number of node descriptions or bases refering to this. */
+    int refCount_;
+
+    /** Full basis, NULL if stored as a difference. */
+    CoinWarmStartBasis *basis_;
+
+    /** Basis this one is relative to, NULL if stored in full. */
+    BlisSharedBasis *parent_;
+
+    /** Difference from the basis of parent_. */
+    CoinWarmStartDiff *diff_;
+
+    /** Number of differences to apply to reach a full basis. */
+    int numDiffs_;
+
+    /** Size of the basis. */
+    int numStructural_;
+    int numArtificial_;
+
+    /** Store a full basis after this many differences. */
+    static const int maxNumDiffs_ = 16;
+
+    /** Deleted by release() only. */
+    ~BlisSharedBasis() {
+        delete basis_;
+        delete diff_;
+        if (parent_) {
+            parent_->release();
+        }
+    }
+
+    /** No copy constructor, assignment operator. */
+    BlisSharedBasis(const BlisSharedBasis&);
+    BlisSharedBasis& operator=(const BlisSharedBasis&);
+
+ public:
+
+    /** Useful constructor. Take over the memory ownship of ws. If parent is
+        given, only the difference from the parent basis is kept. */
+    BlisSharedBasis(CoinWarmStartBasis *&ws, BlisSharedBasis *parent = NULL)
+        :
+        refCount_(1),
+        basis_(NULL),
+        parent_(NULL),
+        diff_(NULL),
+        numDiffs_(0),
+        numStructural_(ws->getNumStructural()),
+        numArtificial_(ws->getNumArtificial())
+        {
+            if (parent && parent->numDiffs_ < maxNumDiffs_) {
+                CoinWarmStartBasis *old = parent->createBasis();
+                // A difference can not be generated from a larger basis,
+                // i.e., after constraints are removed.
+                if (old->getNumStructural() <= ws->getNumStructural() &&
+                    old->getNumArtificial() <= ws->getNumArtificial()) {
+                    diff_ = ws->generateDiff(old);
+                    parent_ = parent->share();
+                    numDiffs_ = parent->numDiffs_ + 1;
+                }
+                delete old;
+            }
+            if (diff_) {
+                delete ws;
+            }
+            else {
+                basis_ = ws;
+            }
+            ws = NULL;
+        }
+
+    /** Add a reference and return this. */
+    BlisSharedBasis * share() { ++refCount_; return this; }
+
+    /** Number of descriptions and bases referring to this one. */
+    int getRefCount() const { return refCount_; }
+
+    /** Remove a reference, free memory when it is the last one. */
+    void release() {
+        if (--refCount_ == 0) {
+            delete this;
+        }
+    }
+
+    /** Return the number of bytes owned, not counting the parent. A
+        difference is counted by its object size only. */
+    size_t getMemoryUsage() const {
+        size_t bytes = sizeof(BlisSharedBasis);
+        if (basis_) {
+            // Two bits per status, packed into ints.
+            bytes += 4 * ((numStructural_ + 15) / 16 +
+                          (numArtificial_ + 15) / 16);
+        }
+        if (diff_) {
+            bytes += sizeof(CoinWarmStartBasisDiff);
+        }
+        return bytes;
+    }
+
+    /** Create a full copy of the basis. The caller owns the memory. */
+    CoinWarmStartBasis * createBasis() const {
+        if (basis_) {
+            return new CoinWarmStartBasis(*basis_);
+        }
+        CoinWarmStartBasis *ws = parent_->createBasis();
+        ws->resize(numArtificial_, numStructural_);
+        ws->applyDiff(diff_);
+        return ws;
+    }
+};
+
+//#############################################################################
+
 
 class BlisNodeDesc : public BcpsNodeDesc {
 
@@ -51,7 +239,11 @@ class BlisNodeDesc : public BcpsNodeDesc {
     double branchedVal_;
 
     /** Warm start. */
-    CoinWarmStartBasis *basis_;
+    BlisSharedBasis *basis_;
+
+    /** Shared explicit hard variable bounds, hard bound lists of this
+        description modify them. NULL if not used. */
+    BlisSharedBounds *sharedHardBounds_;
 
  public:
 
@@ -61,7 +253,8 @@ class BlisNodeDesc : public BcpsNodeDesc {
         branchedDir_(0),
         branchedInd_(-1),
         branchedVal_(0.0),
-	basis_(NULL)
+	basis_(NULL),
+	sharedHardBounds_(NULL)
         {}
 
     /** Useful constructor. */
@@ -71,21 +264,70 @@ class BlisNodeDesc : public BcpsNodeDesc {
         branchedDir_(0),
         branchedInd_(-1),
         branchedVal_(0.0),
-	basis_(NULL)
+	basis_(NULL),
+	sharedHardBounds_(NULL)
 	{}
 
     /** Destructor. */
-    virtual ~BlisNodeDesc() { delete basis_; }
+    virtual ~BlisNodeDesc() {
+        if (basis_) {
+            basis_->release();
+        }
+        if (sharedHardBounds_) {
+            sharedHardBounds_->release();
+        }
+    }
 
-    /** Set basis. */
+    /** Set basis. Take over the memory ownship of ws. The basis is stored
+        as the difference from the current basis of this description,
+        which is the one inherited from the parent. */
     void setBasis(CoinWarmStartBasis *&ws) {
-        if (basis_) { delete basis_; }
-        basis_= ws;
+        BlisSharedBasis *old = basis_;
+        basis_ = ws ? new BlisSharedBasis(ws, old) : NULL;
+        if (old) { old->release(); }
         ws = NULL;
     }
 
-    /** Get warm start basis. */
-    CoinWarmStartBasis * getBasis() const { return basis_; }
+    /** Set shared basis. Take over the reference given, the caller should
+        call share() if it keeps the basis too. */
+    void setSharedBasis(BlisSharedBasis *b) {
+        if (basis_) { basis_->release(); }
+        basis_ = b;
+    }
+
+    /** Get shared basis. */
+    BlisSharedBasis * getSharedBasis() const { return basis_; }
+
+    /** Return the number of bytes owned by this description. The basis
+        stays in memory when the description is spilled. A basis shared
+        with siblings is counted by its share, shared hard bounds are not
+        counted. */
+    virtual size_t getMemoryUsage() const {
+        size_t bytes = BcpsNodeDesc::getMemoryUsage();
+        bytes += sizeof(BlisNodeDesc) - sizeof(BcpsNodeDesc);
+        if (basis_) {
+            bytes += basis_->getMemoryUsage() / basis_->getRefCount();
+        }
+        return bytes;
+    }
+
+    /** Create a full copy of the warm start basis, NULL if not available.
+        The caller owns the memory. */
+    CoinWarmStartBasis * createBasis() const {
+        return basis_ ? basis_->createBasis() : NULL;
+    }
+
+    /** Set shared hard variable bounds. Take over the reference given, the
+        caller should call share() if it keeps the block too. */
+    void setSharedHardBounds(BlisSharedBounds *b) {
+        if (sharedHardBounds_) { sharedHardBounds_->release(); }
+        sharedHardBounds_ = b;
+    }
+
+    /** Get shared hard variable bounds. */
+    BlisSharedBounds * getSharedHardBounds() const {
+        return sharedHardBounds_;
+    }
 
     /** Set branching direction. */
     void setBranchedDir(int d) { branchedDir_ = d; }
@@ -117,21 +359,28 @@ class BlisNodeDesc : public BcpsNodeDesc {
         encoded->writeRep(branchedDir_);
         encoded->writeRep(branchedInd_);
         encoded->writeRep(branchedVal_);
+        // Encode shared hard bounds if used
+        int shared = 0;
+        if (sharedHardBounds_) {
+            shared = 1;
+            encoded->writeRep(shared);
+            encoded->writeRep(sharedHardBounds_->getLower(),
+                              sharedHardBounds_->getSize());
+            encoded->writeRep(sharedHardBounds_->getUpper(),
+                              sharedHardBounds_->getSize());
+        }
+        else {
+            encoded->writeRep(shared);
+        }
         // Encode basis if available
         int available = 0;
         if (basis_) {
             available = 1;
             encoded->writeRep(available);
-            int numCols = basis_->getNumStructural();
-            int numRows = basis_->getNumArtificial();
-            encoded->writeRep(numCols);
-            encoded->writeRep(numRows);
-            // Pack structural.
-            int nint = (basis_->getNumStructural() + 15) >> 4;
-            encoded->writeRep(basis_->getStructuralStatus(), nint * 4);
-            // Pack artificial.
-            nint = (basis_->getNumArtificial() + 15) >> 4;
-            encoded->writeRep(basis_->getArtificialStatus(), nint * 4);
+            // Receiver does not have the parent, send full basis.
+            CoinWarmStartBasis * ws = basis_->createBasis();
+            BlisEncodeWarmStart(encoded, ws);
+            delete ws;
         }
         else {
             encoded->writeRep(available);
@@ -160,42 +409,43 @@ class BlisNodeDesc : public BcpsNodeDesc {
         encoded.readRep(branchedDir_);
         encoded.readRep(branchedInd_);
         encoded.readRep(branchedVal_);
+        // decode shared hard bounds if used
+        int shared;
+        encoded.readRep(shared);
+        if (shared==1) {
+            int size;
+            double * lower = NULL;
+            double * upper = NULL;
+            encoded.readRep(lower, size);
+            encoded.readRep(upper, size);
+            setSharedHardBounds(new BlisSharedBounds(size, lower, upper));
+        }
+        else {
+            setSharedHardBounds(NULL);
+        }
         // decode basis if available
         int available;
         encoded.readRep(available);
         if (available==1) {
-            if (basis_) {
-                delete basis_;
-            }
-            int numCols;
-            int numRows;
-            encoded.readRep(numCols);
-            encoded.readRep(numRows);
-            int tempInt;
-            // Structural
-            int nint = (numCols + 15) >> 4;
-            char * structuralStatus = new char[4 * nint];
-            encoded.readRep(structuralStatus, tempInt);
-            assert(tempInt == nint*4);
-            // Artificial
-            nint = (numRows + 15) >> 4;
-            char * artificialStatus = new char[4 * nint];
-            encoded.readRep(artificialStatus, tempInt);
-            assert(tempInt == nint*4);
-            basis_ = new CoinWarmStartBasis();
-            if (!basis_) {
-                throw CoinError("Out of memory", "BlisDecodeWarmStart", "HELP");
-            }
-            basis_->assignBasisStatus(numCols, numRows,
-                              structuralStatus, artificialStatus);
-            assert(!structuralStatus);
-            assert(!artificialStatus);
+            CoinWarmStartBasis * ws = BlisDecodeWarmStart(encoded, &status);
+            setSharedBasis(new BlisSharedBasis(ws));
         }
         else {
-            basis_ = NULL;
+            setSharedBasis(NULL);
         }
         return status;
     }
+
+    /// Decode an added object. Blis only adds constraints (cuts).
+    virtual BcpsObject * decodeObject(AlpsEncoded &encoded, int type) const {
+        if (type != BcpsKnowledgeTypeConstraint) {
+            std::cerr << "BlisNodeDesc::decodeObject: unknown object type "
+                      << type << std::endl;
+            throw std::exception();
+        }
+        BlisConstraint con;
+        return dynamic_cast<BcpsObject *>(con.decode(encoded));
+    }
     ///@}
 };
 #endif
@@ -45,6 +45,21 @@ BlisParams::createKeywordList() {
   keys_.push_back(make_pair(std::string("Blis_cutDuringRampup"),
 			    AlpsParameter(AlpsBoolPar, cutDuringRampup)));
 
+  keys_.push_back(make_pair(std::string("Blis_instanceCache"),
+			    AlpsParameter(AlpsBoolPar, instanceCache)));
+
+  keys_.push_back(make_pair(std::string("Blis_sharedModel"),
+			    AlpsParameter(AlpsBoolPar, sharedModel)));
+
+  keys_.push_back(make_pair(std::string("Blis_globalRcFix"),
+			    AlpsParameter(AlpsBoolPar, globalRcFix)));
+
+  keys_.push_back(make_pair(std::string("Blis_heurThread"),
+			    AlpsParameter(AlpsBoolPar, heurThread)));
+
+  keys_.push_back(make_pair(std::string("Blis_removeSlackCons"),
+			    AlpsParameter(AlpsBoolPar, removeSlackCons)));
+
   //--------------------------------------------------------
   // BoolArrayPar
   //--------------------------------------------------------
@@ -65,6 +80,21 @@ BlisParams::createKeywordList() {
   keys_.push_back(make_pair(std::string("Blis_heurRound"),
 			    AlpsParameter(AlpsIntPar, heurRound)));
 
+  keys_.push_back(make_pair(std::string("Blis_heurDiveFrac"),
+			    AlpsParameter(AlpsIntPar, heurDiveFrac)));
+
+  keys_.push_back(make_pair(std::string("Blis_heurDiveCoef"),
+			    AlpsParameter(AlpsIntPar, heurDiveCoef)));
+
+  keys_.push_back(make_pair(std::string("Blis_heurDivePseudo"),
+			    AlpsParameter(AlpsIntPar, heurDivePseudo)));
+
+  keys_.push_back(make_pair(std::string("Blis_heurDiveGuided"),
+			    AlpsParameter(AlpsIntPar, heurDiveGuided)));
+
+  keys_.push_back(make_pair(std::string("Blis_heurFPump"),
+			    AlpsParameter(AlpsIntPar, heurFPump)));
+
   keys_.push_back(make_pair(std::string("Blis_cutClique"),
 			    AlpsParameter(AlpsIntPar, cutClique)));
 
@@ -89,6 +119,12 @@ BlisParams::createKeywordList() {
   keys_.push_back(make_pair(std::string("Blis_cutTwoMir"),
 			    AlpsParameter(AlpsIntPar, cutTwoMir)));
 
+  keys_.push_back(make_pair(std::string("Blis_cutPass"),
+			    AlpsParameter(AlpsIntPar, cutPass)));
+
+  keys_.push_back(make_pair(std::string("Blis_cutInactiveLimit"),
+			    AlpsParameter(AlpsIntPar, cutInactiveLimit)));
+
   keys_.push_back(make_pair(std::string("Blis_pseudoRelibility"),
 			    AlpsParameter(AlpsIntPar, pseudoRelibility)));
 
@@ -98,6 +134,21 @@ BlisParams::createKeywordList() {
   keys_.push_back(make_pair(std::string("Blis_objSense"),
 			    AlpsParameter(AlpsIntPar, objSense)));
 
+  keys_.push_back(make_pair(std::string("Blis_presolvePass"),
+			    AlpsParameter(AlpsIntPar, presolvePass)));
+
+  keys_.push_back(make_pair(std::string("Blis_propagatePass"),
+			    AlpsParameter(AlpsIntPar, propagatePass)));
+
+  keys_.push_back(make_pair(std::string("Blis_diveDepth"),
+			    AlpsParameter(AlpsIntPar, diveDepth)));
+
+  keys_.push_back(make_pair(std::string("Blis_nodeMemoryLimit"),
+			    AlpsParameter(AlpsIntPar, nodeMemoryLimit)));
+
+  keys_.push_back(make_pair(std::string("Blis_solPoolSize"),
+			    AlpsParameter(AlpsIntPar, solPoolSize)));
+
 
   //--------------------------------------------------------
   // Double Parameters.
@@ -129,6 +180,19 @@ BlisParams::createKeywordList() {
 
   keys_.push_back(make_pair(std::string("Blis_cutoff"),
 			    AlpsParameter(AlpsDoublePar, cutoff)));
+
+  keys_.push_back(make_pair(std::string("Blis_heurNodeTime"),
+			    AlpsParameter(AlpsDoublePar, heurNodeTime)));
+
+  keys_.push_back(make_pair(std::string("Blis_heurDiveIterRatio"),
+			    AlpsParameter(AlpsDoublePar, heurDiveIterRatio)));
+
+  keys_.push_back(make_pair(std::string("Blis_heurFPumpTime"),
+			    AlpsParameter(AlpsDoublePar, heurFPumpTime)));
+
+  keys_.push_back(make_pair(std::string("Blis_diveGap"),
+			    AlpsParameter(AlpsDoublePar, diveGap)));
+
   //--------------------------------------------------------
   // String Parameters.
   //--------------------------------------------------------
@@ -147,6 +211,11 @@ BlisParams::setDefaultEntries() {
   setEntry(useHeuristics, true);
   setEntry(cutDuringRampup, false);
   setEntry(useCons, true);
+  setEntry(instanceCache, false);
+  setEntry(sharedModel, false);
+  setEntry(globalRcFix, false);
+  setEntry(heurThread, false);
+  setEntry(removeSlackCons, false);
 
   //-------------------------------------------------------------
   // Int Parameters.
@@ -156,6 +225,11 @@ BlisParams::setDefaultEntries() {
   // setEntry(logLevel, 0);
   setEntry(branchStrategy, 1);
   setEntry(heurRound, 0);
+  setEntry(heurDiveFrac, -2);
+  setEntry(heurDiveCoef, -2);
+  setEntry(heurDivePseudo, -2);
+  setEntry(heurDiveGuided, -2);
+  setEntry(heurFPump, -2);
   setEntry(cutClique, 0);
   setEntry(cutGomory, 0);
   setEntry( cutFlowCover, 0);
@@ -164,9 +238,16 @@ BlisParams::setDefaultEntries() {
   setEntry(cutOddHole, -2);
   setEntry(cutProbing, 0);
   setEntry(cutTwoMir, -2);
+  setEntry(cutPass, 0);
+  setEntry(cutInactiveLimit, 3);
   setEntry(pseudoRelibility, 8);
   setEntry(lookAhead, 4);
   setEntry(objSense, 1);
+  setEntry(presolvePass, 0);
+  setEntry(propagatePass, 0);
+  setEntry(diveDepth, 0);
+  setEntry(nodeMemoryLimit, 0);
+  setEntry(solPoolSize, 10);
 
   //-------------------------------------------------------------
   // Double Parameters
@@ -181,6 +262,10 @@ BlisParams::setDefaultEntries() {
   setEntry(denseConFactor, 5.0);
   setEntry(scaleConFactor, 1000000.0);
   setEntry(cutoff, 1e20);
+  setEntry(heurNodeTime, 1.0);
+  setEntry(heurDiveIterRatio, 0.05);
+  setEntry(heurFPumpTime, 10.0);
+  setEntry(diveGap, 0.5);
 
   //-------------------------------------------------------------
   // String Parameters
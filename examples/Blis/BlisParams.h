@@ -43,6 +43,27 @@ class BlisParams : public AlpsParameterSet {
     useHeuristics,
     /// Whether generate cuts during rampup. Default: false.
     cutDuringRampup,
+    /** Whether keep a binary cache (instance file + ".bbin") of the
+        instance next to the instance file and read it instead of the
+        instance file when it is up to date. Default: false. */
+    instanceCache,
+    /** Whether ranks on the same host share one read-only copy of the
+        core column matrix, bounds, objective and column types in POSIX
+        shared memory. Every rank still decodes the whole model, and the
+        lp solver and the row ordered matrix stay private, so memory per
+        rank still grows with the matrix. Ignored where POSIX shared
+        memory is not available. Default: false. */
+    sharedModel,
+    /** Whether fix columns at every node by the root reduced costs when
+        a better incumbent is found, and share these global bounds with
+        other processes. Default: false. */
+    globalRcFix,
+    /** Whether run the primal heuristics in a background thread on
+        snapshots of node lps. Default: false. */
+    heurThread,
+    /** Whether remove non-core constraints that stayed slack for
+        cutInactiveLimit rounds from the node lp. Default: false. */
+    removeSlackCons,
     //
     endOfBoolParams
   };
@@ -71,6 +92,17 @@ class BlisParams : public AlpsParameterSet {
       */
       heurRound,
 
+      /** Diving heuristics control, same values as heurRound.
+          Default: -2 (disabled). */
+      heurDiveFrac,
+      heurDiveCoef,
+      heurDivePseudo,
+      heurDiveGuided,
+
+      /** Feasibility pump control, same values as heurRound. It runs once
+          at most, while there is no incumbent. Default: -2 (disabled). */
+      heurFPump,
+
       /** Cut generators control.
           -1: disable,
           0: default,
@@ -85,12 +117,37 @@ class BlisParams : public AlpsParameterSet {
       cutOddHole,
       cutProbing,
       cutTwoMir,
+      /** Maximum number of constraint generation rounds at a node.
+          0: disable. Default: 0. */
+      cutPass,
+      /** Number of consecutive rounds a non-core constraint can stay slack
+          before it is removed from the lp and the node description.
+          0: never remove. Default: 3. */
+      cutInactiveLimit,
       /** The relibility of pseudocost. */
       pseudoRelibility,
       /** The look ahead of pseudocost. */
       lookAhead,
       /// optimization direction, 1 for min, -1 for max.
       objSense,
+      /** Maximum number of root presolve passes. 0: disable.
+          Default: 0. */
+      presolvePass,
+      /** Maximum number of passes over the rows in domain propagation
+          at a node. 0: disable. Default: 0. */
+      propagatePass,
+      /** Maximum number of children a node processes in place after it
+          is branched on. Each one keeps the lp of its parent with only
+          the branching bound changed, the other child goes to the node
+          pool. 0: disable. Default: 0. */
+      diveDepth,
+      /** Memory budget in megabytes for the descriptions of the nodes
+          waiting in the node pool. Above it, the worst nodes are spilled
+          to a local file. 0: no limit. Default: 0. */
+      nodeMemoryLimit,
+      /** Number of best distinct solutions kept in the solution pool for
+          solution-guided heuristics. Default: 10. */
+      solPoolSize,
       //
       endOfIntParams
   };
@@ -127,6 +184,18 @@ class BlisParams : public AlpsParameterSet {
     /// objective cutoff, relaxations with objective value higher than this can
     /// be fathomed.
     cutoff,
+    /** Cpu seconds the primal heuristics may use at a node, over all
+        bounding passes. Default: 1.0 */
+    heurNodeTime,
+    /** Lp iterations each diving heuristic may use, as a fraction of the lp
+        iterations of the search. Default: 0.05 */
+    heurDiveIterRatio,
+    /** Cpu seconds the feasibility pump may use. Default: 10.0 */
+    heurFPumpTime,
+    /** A dive in place stops once the lp bound has moved by more than this
+        fraction of the gap between the bound where it started and the
+        cutoff. Default: 0.5 */
+    diveGap,
     endOfDblParams
   };
 
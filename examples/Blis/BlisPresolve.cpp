@@ -0,0 +1,635 @@
+/*===========================================================================*
+ * This file is part of the Bcps Linear Solver (BLIS).                       *
+ *                                                                           *
+ * BLIS is distributed under the Eclipse Public License as part of the       *
+ * COIN-OR repository (http://www.coin-or.org).                              *
+ *                                                                           *
+ * Authors:                                                                  *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *                                                                           *
+ * Conceptual Design:                                                        *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *          Laszlo Ladanyi, IBM T.J. Watson Research Center                  *
+ *          Matthew Saltzman, Clemson University                             *
+ *                                                                           *
+ *                                                                           *
+ * Copyright (C) 2001-2017, Lehigh University, Yan Xu, and Ted Ralphs.       *
+ * All Rights Reserved.                                                      *
+ *===========================================================================*/
+
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#include "CoinFinite.hpp"
+#include "CoinHelperFunctions.hpp"
+
+#include "BlisPresolve.h"
+
+//#############################################################################
+
+/** Bounds at or beyond this magnitude are treated as infinite. */
+#define BLIS_PRESOLVE_INF 1.0e20
+
+/** Feasibility tolerance used when comparing activities and bounds. */
+#define BLIS_PRESOLVE_TOL 1.0e-6
+
+//#############################################################################
+
+BlisPresolve::BlisPresolve()
+    :
+    numOrigCols_(0),
+    numOrigRows_(0),
+    numCols_(0),
+    numRows_(0),
+    colMap_(NULL),
+    fixedValue_(NULL),
+    objOffset_(0.0),
+    matrix_(NULL),
+    colLower_(NULL),
+    colUpper_(NULL),
+    objective_(NULL),
+    rowLower_(NULL),
+    rowUpper_(NULL),
+    colType_(NULL),
+    numTightenedBounds_(0),
+    numTightenedCoefs_(0)
+{}
+
+//#############################################################################
+
+void
+BlisPresolve::gutsOfDestructor()
+{
+    delete [] colMap_;
+    colMap_ = NULL;
+    delete [] fixedValue_;
+    fixedValue_ = NULL;
+    delete matrix_;
+    matrix_ = NULL;
+    delete [] colLower_;
+    colLower_ = NULL;
+    delete [] colUpper_;
+    colUpper_ = NULL;
+    delete [] objective_;
+    objective_ = NULL;
+    delete [] rowLower_;
+    rowLower_ = NULL;
+    delete [] rowUpper_;
+    rowUpper_ = NULL;
+    delete [] colType_;
+    colType_ = NULL;
+}
+
+//#############################################################################
+
+int
+BlisPresolve::tightenBounds(int j, double newLb, double newUb,
+                            bool isInteger, double *lower, double *upper)
+{
+    int changed = 0;
+
+    if (isInteger) {
+        if (newLb > -BLIS_PRESOLVE_INF) {
+            newLb = ceil(newLb - BLIS_PRESOLVE_TOL);
+        }
+        if (newUb < BLIS_PRESOLVE_INF) {
+            newUb = floor(newUb + BLIS_PRESOLVE_TOL);
+        }
+    }
+
+    if (newLb > lower[j] + BLIS_PRESOLVE_TOL) {
+        lower[j] = newLb;
+        changed = 1;
+    }
+    if (newUb < upper[j] - BLIS_PRESOLVE_TOL) {
+        upper[j] = newUb;
+        changed = 1;
+    }
+
+    if (lower[j] > upper[j]) {
+        if (lower[j] > upper[j] + BLIS_PRESOLVE_TOL) {
+            return -1;
+        }
+        // Crossed within tolerance, fix the column.
+        lower[j] = upper[j];
+    }
+
+    return changed;
+}
+
+//#############################################################################
+
+int
+BlisPresolve::presolve(const CoinPackedMatrix &matrix,
+                       const double *colLower, const double *colUpper,
+                       const double *objective,
+                       const double *rowLower, const double *rowUpper,
+                       const char *colType,
+                       double objSense,
+                       int maxPasses)
+{
+    int i, j, pass;
+    CoinBigIndex k;
+
+    gutsOfDestructor();
+    objOffset_ = 0.0;
+    numTightenedBounds_ = 0;
+    numTightenedCoefs_ = 0;
+
+    const int numCols = matrix.getNumCols();
+    const int numRows = matrix.getNumRows();
+
+    numOrigCols_ = numCols;
+    numOrigRows_ = numRows;
+
+    //------------------------------------------------------
+    // Work on a row ordered copy, coefficients may change.
+    //------------------------------------------------------
+
+    CoinPackedMatrix byRow;
+    if (matrix.isColOrdered()) {
+        byRow.reverseOrderedCopyOf(matrix);
+    }
+    else {
+        byRow = matrix;
+    }
+
+    double *elements = byRow.getMutableElements();
+    const int *indices = byRow.getIndices();
+    const CoinBigIndex *starts = byRow.getVectorStarts();
+    const int *lengths = byRow.getVectorLengths();
+
+    std::vector<double> lower(colLower, colLower + numCols);
+    std::vector<double> upper(colUpper, colUpper + numCols);
+    std::vector<double> rlower(rowLower, rowLower + numRows);
+    std::vector<double> rupper(rowUpper, rowUpper + numRows);
+    std::vector<char> isInteger(numCols, 0);
+    std::vector<char> rowRemoved(numRows, 0);
+    std::vector<int> colCount(numCols, 0);
+
+    for (j = 0; j < numCols; ++j) {
+        isInteger[j] = (colType[j] != 'C');
+        if (isInteger[j]) {
+            if (lower[j] > -BLIS_PRESOLVE_INF) {
+                lower[j] = ceil(lower[j] - BLIS_PRESOLVE_TOL);
+            }
+            if (upper[j] < BLIS_PRESOLVE_INF) {
+                upper[j] = floor(upper[j] + BLIS_PRESOLVE_TOL);
+            }
+            if (lower[j] > upper[j]) {
+                return -1;
+            }
+        }
+    }
+    for (i = 0; i < numRows; ++i) {
+        for (k = starts[i]; k < starts[i] + lengths[i]; ++k) {
+            if (elements[k] != 0.0) {
+                ++colCount[indices[k]];
+            }
+        }
+    }
+
+    int numRemovedRows = 0;
+
+    for (pass = 0; pass < maxPasses; ++pass) {
+        int numChanges = 0;
+
+        for (i = 0; i < numRows; ++i) {
+            if (rowRemoved[i]) continue;
+
+            const CoinBigIndex rowStart = starts[i];
+            const CoinBigIndex rowEnd = starts[i] + lengths[i];
+
+            //--------------------------------------------------
+            // Activity bounds over the columns not yet fixed.
+            //--------------------------------------------------
+
+            double minAct = 0.0, maxAct = 0.0, fixedAct = 0.0;
+            int minInf = 0, maxInf = 0, numActive = 0;
+            int lastCol = -1;
+            double lastCoef = 0.0;
+
+            for (k = rowStart; k < rowEnd; ++k) {
+                double a = elements[k];
+                if (a == 0.0) continue;
+                j = indices[k];
+                if (upper[j] - lower[j] <= 0.0) {
+                    fixedAct += a * lower[j];
+                    continue;
+                }
+                ++numActive;
+                lastCol = j;
+                lastCoef = a;
+                if (a > 0.0) {
+                    if (lower[j] <= -BLIS_PRESOLVE_INF) ++minInf;
+                    else minAct += a * lower[j];
+                    if (upper[j] >= BLIS_PRESOLVE_INF) ++maxInf;
+                    else maxAct += a * upper[j];
+                }
+                else {
+                    if (upper[j] >= BLIS_PRESOLVE_INF) ++minInf;
+                    else minAct += a * upper[j];
+                    if (lower[j] <= -BLIS_PRESOLVE_INF) ++maxInf;
+                    else maxAct += a * lower[j];
+                }
+            }
+
+            const bool hasLower = (rlower[i] > -BLIS_PRESOLVE_INF);
+            const bool hasUpper = (rupper[i] < BLIS_PRESOLVE_INF);
+            double L = hasLower ? rlower[i] - fixedAct : -COIN_DBL_MAX;
+            double U = hasUpper ? rupper[i] - fixedAct : COIN_DBL_MAX;
+
+            //--------------------------------------------------
+            // Empty row.
+            //--------------------------------------------------
+
+            if (numActive == 0) {
+                if (L > BLIS_PRESOLVE_TOL || U < -BLIS_PRESOLVE_TOL) {
+                    return -1;
+                }
+                rowRemoved[i] = 1;
+                ++numRemovedRows;
+                ++numChanges;
+                continue;
+            }
+
+            //--------------------------------------------------
+            // Singleton row, becomes a column bound.
+            //--------------------------------------------------
+
+            if (numActive == 1) {
+                double newLb = -COIN_DBL_MAX, newUb = COIN_DBL_MAX;
+                if (lastCoef > 0.0) {
+                    if (hasLower) newLb = L / lastCoef;
+                    if (hasUpper) newUb = U / lastCoef;
+                }
+                else {
+                    if (hasUpper) newLb = U / lastCoef;
+                    if (hasLower) newUb = L / lastCoef;
+                }
+                if (tightenBounds(lastCol, newLb, newUb,
+                                  isInteger[lastCol] != 0,
+                                  &lower[0], &upper[0]) < 0) {
+                    return -1;
+                }
+                rowRemoved[i] = 1;
+                --colCount[lastCol];
+                ++numRemovedRows;
+                ++numChanges;
+                continue;
+            }
+
+            //--------------------------------------------------
+            // Infeasible or redundant row.
+            //--------------------------------------------------
+
+            if ((hasLower && maxInf == 0 && maxAct < L - BLIS_PRESOLVE_TOL) ||
+                (hasUpper && minInf == 0 && minAct > U + BLIS_PRESOLVE_TOL)) {
+                return -1;
+            }
+
+            if ((!hasLower ||
+                 (minInf == 0 && minAct >= L - BLIS_PRESOLVE_TOL)) &&
+                (!hasUpper ||
+                 (maxInf == 0 && maxAct <= U + BLIS_PRESOLVE_TOL))) {
+                for (k = rowStart; k < rowEnd; ++k) {
+                    j = indices[k];
+                    if (elements[k] != 0.0 && upper[j] > lower[j]) {
+                        --colCount[j];
+                    }
+                }
+                rowRemoved[i] = 1;
+                ++numRemovedRows;
+                ++numChanges;
+                continue;
+            }
+
+            //--------------------------------------------------
+            // Implied bounds of integer columns. The activity
+            // bounds are not updated, they only get looser.
+            //--------------------------------------------------
+
+            for (k = rowStart; k < rowEnd; ++k) {
+                double a = elements[k];
+                j = indices[k];
+                if (a == 0.0 || !isInteger[j] || upper[j] <= lower[j]) {
+                    continue;
+                }
+                double newLb = -COIN_DBL_MAX, newUb = COIN_DBL_MAX;
+                if (hasUpper && minInf == 0) {
+                    double slack = U - minAct;
+                    if (a > 0.0) newUb = lower[j] + slack / a;
+                    else newLb = upper[j] + slack / a;
+                }
+                if (hasLower && maxInf == 0) {
+                    double slack = maxAct - L;
+                    if (a > 0.0) newLb = CoinMax(newLb, upper[j] - slack / a);
+                    else newUb = CoinMin(newUb, lower[j] - slack / a);
+                }
+                int status = tightenBounds(j, newLb, newUb, true,
+                                           &lower[0], &upper[0]);
+                if (status < 0) {
+                    return -1;
+                }
+                if (status > 0) {
+                    ++numTightenedBounds_;
+                    ++numChanges;
+                }
+            }
+
+            //--------------------------------------------------
+            // Coefficient tightening of binary columns in one
+            // sided rows.
+            //--------------------------------------------------
+
+            if (!hasLower && hasUpper && maxInf == 0) {
+                for (k = rowStart; k < rowEnd; ++k) {
+                    double a = elements[k];
+                    j = indices[k];
+                    if (a == 0.0 || !isInteger[j] ||
+                        lower[j] != 0.0 || upper[j] != 1.0) {
+                        continue;
+                    }
+                    if (a > 0.0 && maxAct - a < U - BLIS_PRESOLVE_TOL) {
+                        double d = U - (maxAct - a);
+                        if (a - d < BLIS_PRESOLVE_TOL) continue;
+                        elements[k] = a - d;
+                        rupper[i] -= d;
+                        U -= d;
+                        maxAct -= d;
+                        ++numTightenedCoefs_;
+                        ++numChanges;
+                    }
+                    else if (a < 0.0 && maxAct + a < U - BLIS_PRESOLVE_TOL) {
+                        double d = U - (maxAct + a);
+                        if (a + d > -BLIS_PRESOLVE_TOL) continue;
+                        elements[k] = a + d;
+                        ++numTightenedCoefs_;
+                        ++numChanges;
+                    }
+                }
+            }
+            else if (hasLower && !hasUpper && minInf == 0) {
+                for (k = rowStart; k < rowEnd; ++k) {
+                    double a = elements[k];
+                    j = indices[k];
+                    if (a == 0.0 || !isInteger[j] ||
+                        lower[j] != 0.0 || upper[j] != 1.0) {
+                        continue;
+                    }
+                    if (a > 0.0 && minAct + a > L + BLIS_PRESOLVE_TOL) {
+                        double d = minAct + a - L;
+                        if (a - d < BLIS_PRESOLVE_TOL) continue;
+                        elements[k] = a - d;
+                        ++numTightenedCoefs_;
+                        ++numChanges;
+                    }
+                    else if (a < 0.0 && minAct - a > L + BLIS_PRESOLVE_TOL) {
+                        double d = minAct - a - L;
+                        if (a + d > -BLIS_PRESOLVE_TOL) continue;
+                        elements[k] = a + d;
+                        rlower[i] += d;
+                        L += d;
+                        minAct += d;
+                        ++numTightenedCoefs_;
+                        ++numChanges;
+                    }
+                }
+            }
+        }
+
+        //------------------------------------------------------
+        // Columns in no row are fixed at their best bound.
+        //------------------------------------------------------
+
+        for (j = 0; j < numCols; ++j) {
+            if (colCount[j] > 0 || upper[j] <= lower[j]) continue;
+            double cost = objSense * objective[j];
+            double value;
+            if (cost > 0.0 || (cost == 0.0 && lower[j] > -BLIS_PRESOLVE_INF)) {
+                value = lower[j];
+            }
+            else {
+                value = upper[j];
+            }
+            if (fabs(value) >= BLIS_PRESOLVE_INF) {
+                // Unbounded or free, leave it to the LP.
+                continue;
+            }
+            lower[j] = upper[j] = value;
+            ++numChanges;
+        }
+
+        if (numChanges == 0) break;
+    }
+
+    //------------------------------------------------------
+    // Collect kept columns and rows.
+    //------------------------------------------------------
+
+    std::vector<int> delCols;
+    std::vector<int> delRows;
+
+    fixedValue_ = new double [numCols];
+    CoinZeroN(fixedValue_, numCols);
+
+    for (j = 0; j < numCols; ++j) {
+        if (upper[j] <= lower[j] && fabs(lower[j]) < BLIS_PRESOLVE_INF) {
+            fixedValue_[j] = lower[j];
+            objOffset_ += objective[j] * lower[j];
+            delCols.push_back(j);
+        }
+    }
+    for (i = 0; i < numRows; ++i) {
+        if (rowRemoved[i]) delRows.push_back(i);
+    }
+
+    if (delCols.empty() && delRows.empty() &&
+        numTightenedBounds_ == 0 && numTightenedCoefs_ == 0) {
+        gutsOfDestructor();
+        return 1;
+    }
+
+    numCols_ = numCols - static_cast<int>(delCols.size());
+    numRows_ = numRows - static_cast<int>(delRows.size());
+
+    colMap_ = new int [numCols_];
+    colLower_ = new double [numCols_];
+    colUpper_ = new double [numCols_];
+    objective_ = new double [numCols_];
+    colType_ = new char [numCols_];
+
+    int count = 0;
+    for (j = 0; j < numCols; ++j) {
+        if (upper[j] <= lower[j] && fabs(lower[j]) < BLIS_PRESOLVE_INF) {
+            continue;
+        }
+        colMap_[count] = j;
+        colLower_[count] = lower[j];
+        colUpper_[count] = upper[j];
+        objective_[count] = objective[j];
+        if (!isInteger[j]) {
+            colType_[count] = 'C';
+        }
+        else if (lower[j] == 0.0 && upper[j] == 1.0) {
+            colType_[count] = 'B';
+        }
+        else {
+            colType_[count] = 'I';
+        }
+        ++count;
+    }
+
+    // Row bounds move by the activity of the removed columns.
+    rowLower_ = new double [numRows_];
+    rowUpper_ = new double [numRows_];
+
+    count = 0;
+    for (i = 0; i < numRows; ++i) {
+        if (rowRemoved[i]) continue;
+        double fixedAct = 0.0;
+        for (k = starts[i]; k < starts[i] + lengths[i]; ++k) {
+            fixedAct += elements[k] * fixedValue_[indices[k]];
+        }
+        rowLower_[count] = rlower[i];
+        rowUpper_[count] = rupper[i];
+        if (rlower[i] > -BLIS_PRESOLVE_INF) rowLower_[count] -= fixedAct;
+        if (rupper[i] < BLIS_PRESOLVE_INF) rowUpper_[count] -= fixedAct;
+        ++count;
+    }
+
+    if (delRows.size() > 0) {
+        byRow.deleteRows(static_cast<int>(delRows.size()), &delRows[0]);
+    }
+    if (delCols.size() > 0) {
+        byRow.deleteCols(static_cast<int>(delCols.size()), &delCols[0]);
+    }
+
+    matrix_ = new CoinPackedMatrix;
+    matrix_->reverseOrderedCopyOf(byRow);
+
+    return 0;
+}
+
+//#############################################################################
+
+CoinPackedMatrix *
+BlisPresolve::releaseMatrix()
+{
+    CoinPackedMatrix *temp = matrix_;
+    matrix_ = NULL;
+    return temp;
+}
+
+//#############################################################################
+
+double *
+BlisPresolve::releaseColLower()
+{
+    double *temp = colLower_;
+    colLower_ = NULL;
+    return temp;
+}
+
+//#############################################################################
+
+double *
+BlisPresolve::releaseColUpper()
+{
+    double *temp = colUpper_;
+    colUpper_ = NULL;
+    return temp;
+}
+
+//#############################################################################
+
+double *
+BlisPresolve::releaseObjective()
+{
+    double *temp = objective_;
+    objective_ = NULL;
+    return temp;
+}
+
+//#############################################################################
+
+double *
+BlisPresolve::releaseRowLower()
+{
+    double *temp = rowLower_;
+    rowLower_ = NULL;
+    return temp;
+}
+
+//#############################################################################
+
+double *
+BlisPresolve::releaseRowUpper()
+{
+    double *temp = rowUpper_;
+    rowUpper_ = NULL;
+    return temp;
+}
+
+//#############################################################################
+
+char *
+BlisPresolve::releaseColType()
+{
+    char *temp = colType_;
+    colType_ = NULL;
+    return temp;
+}
+
+//#############################################################################
+
+void
+BlisPresolve::postsolve(const double *x, double *origX) const
+{
+    CoinDisjointCopyN(fixedValue_, numOrigCols_, origX);
+    for (int j = 0; j < numCols_; ++j) {
+        origX[colMap_[j]] = x[j];
+    }
+}
+
+//#############################################################################
+
+AlpsReturnStatus
+BlisPresolve::encode(AlpsEncoded *encoded) const
+{
+    encoded->writeRep(numOrigCols_);
+    encoded->writeRep(numOrigRows_);
+    encoded->writeRep(numRows_);
+    encoded->writeRep(objOffset_);
+    encoded->writeRep(colMap_, numCols_);
+    encoded->writeRep(fixedValue_, numOrigCols_);
+
+    return AlpsReturnStatusOk;
+}
+
+//#############################################################################
+
+AlpsReturnStatus
+BlisPresolve::decodeToSelf(AlpsEncoded &encoded)
+{
+    int size;
+
+    gutsOfDestructor();
+
+    encoded.readRep(numOrigCols_);
+    encoded.readRep(numOrigRows_);
+    encoded.readRep(numRows_);
+    encoded.readRep(objOffset_);
+    encoded.readRep(colMap_, numCols_);
+    encoded.readRep(fixedValue_, size);
+    assert(size == numOrigCols_);
+
+    return AlpsReturnStatusOk;
+}
+
+//#############################################################################
@@ -0,0 +1,143 @@
+/*===========================================================================*
+ * This file is part of the Bcps Linear Solver (BLIS).                       *
+ *                                                                           *
+ * BLIS is distributed under the Eclipse Public License as part of the       *
+ * COIN-OR repository (http://www.coin-or.org).                              *
+ *                                                                           *
+ * Authors:                                                                  *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *                                                                           *
+ * Conceptual Design:                                                        *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *          Laszlo Ladanyi, IBM T.J. Watson Research Center                  *
+ *          Matthew Saltzman, Clemson University                             *
+ *                                                                           *
+ *                                                                           *
+ * Copyright (C) 2001-2017, Lehigh University, Yan Xu, and Ted Ralphs.       *
+ * All Rights Reserved.                                                      *
+ *===========================================================================*/
+
+#ifndef BlisPresolve_h_
+#define BlisPresolve_h_
+
+#include "CoinPackedMatrix.hpp"
+
+#include "AlpsEncoded.h"
+
+//#############################################################################
+
+/** Root presolve.
+    A small reducer that is applied to the core problem before the tree
+    search. It
+    - removes fixed and empty columns,
+    - turns singleton rows into column bounds and removes them,
+    - removes empty and redundant rows,
+    - tightens bounds of integer columns implied by row activities,
+    - tightens coefficients of binary columns in one sided rows.
+    The integer feasible set does not change, and the only columns removed
+    are at a fixed value. A solution of the reduced problem is mapped back
+    by postsolve(). The objective of the reduced problem differs by the
+    constant getObjOffset().
+*/
+class BlisPresolve {
+ private:
+    /** Illegal copy constructor. */
+    BlisPresolve(const BlisPresolve &);
+
+    /** Illegal assignment operator. */
+    BlisPresolve & operator=(const BlisPresolve &);
+
+    /** Original problem size. */
+    int numOrigCols_;
+    int numOrigRows_;
+
+    /** Reduced problem size. */
+    int numCols_;
+    int numRows_;
+
+    /** Original index of each reduced column. */
+    int *colMap_;
+
+    /** Value of removed original columns, 0 for the others. */
+    double *fixedValue_;
+
+    /** Objective contribution of removed columns. */
+    double objOffset_;
+
+    /** Reduced problem, owned until released. */
+    CoinPackedMatrix *matrix_;
+    double *colLower_;
+    double *colUpper_;
+    double *objective_;
+    double *rowLower_;
+    double *rowUpper_;
+    char *colType_;
+
+    /** Statistics. */
+    int numTightenedBounds_;
+    int numTightenedCoefs_;
+
+    /** Tighten bounds of column j to [newLb, newUb], rounded if integer.
+        Return -1 if the bounds cross, 1 if changed and 0 otherwise. */
+    int tightenBounds(int j, double newLb, double newUb, bool isInteger,
+                      double *lower, double *upper);
+
+    /** Free all data. */
+    void gutsOfDestructor();
+
+ public:
+    /** Default constructor. */
+    BlisPresolve();
+
+    /** Destructor. */
+    ~BlisPresolve() { gutsOfDestructor(); }
+
+    /** Reduce the problem. colType is 'C', 'I' or 'B' for each column.
+        Return 0 if the problem is reduced, 1 if nothing could be done and
+        -1 if the problem is found infeasible. */
+    int presolve(const CoinPackedMatrix &matrix,
+                 const double *colLower, const double *colUpper,
+                 const double *objective,
+                 const double *rowLower, const double *rowUpper,
+                 const char *colType,
+                 double objSense,
+                 int maxPasses);
+
+    /** Problem sizes. */
+    int getNumOrigCols() const { return numOrigCols_; }
+    int getNumOrigRows() const { return numOrigRows_; }
+    int getNumCols() const { return numCols_; }
+    int getNumRows() const { return numRows_; }
+
+    /** Objective value of original problem minus that of reduced one. */
+    double getObjOffset() const { return objOffset_; }
+
+    /** Statistics. */
+    int getNumTightenedBounds() const { return numTightenedBounds_; }
+    int getNumTightenedCoefs() const { return numTightenedCoefs_; }
+
+    /** Release the reduced problem, the caller owns it afterward. */
+    CoinPackedMatrix *releaseMatrix();
+    double *releaseColLower();
+    double *releaseColUpper();
+    double *releaseObjective();
+    double *releaseRowLower();
+    double *releaseRowUpper();
+    char *releaseColType();
+
+    /** Map a solution x of the reduced problem to origX, which has room for
+        getNumOrigCols() values. */
+    void postsolve(const double *x, double *origX) const;
+
+    /** Pack the information needed by postsolve. */
+    AlpsReturnStatus encode(AlpsEncoded *encoded) const;
+
+    /** Unpack the information needed by postsolve. */
+    AlpsReturnStatus decodeToSelf(AlpsEncoded &encoded);
+};
+
+#endif
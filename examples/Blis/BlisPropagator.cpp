@@ -0,0 +1,446 @@
+/*===========================================================================*
+ * This file is part of the Bcps Linear Solver (BLIS).                       *
+ *                                                                           *
+ * BLIS is distributed under the Eclipse Public License as part of the       *
+ * COIN-OR repository (http://www.coin-or.org).                              *
+ *                                                                           *
+ * Authors:                                                                  *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *                                                                           *
+ * Conceptual Design:                                                        *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *          Laszlo Ladanyi, IBM T.J. Watson Research Center                  *
+ *          Matthew Saltzman, Clemson University                             *
+ *                                                                           *
+ *                                                                           *
+ * Copyright (C) 2001-2017, Lehigh University, Yan Xu, and Ted Ralphs.       *
+ * All Rights Reserved.                                                      *
+ *===========================================================================*/
+
+#include <cmath>
+
+#include "CoinFinite.hpp"
+#include "CoinHelperFunctions.hpp"
+
+#include "BlisPropagator.h"
+
+//#############################################################################
+
+/** Bounds at or beyond this magnitude are treated as infinite. */
+#define BLIS_PROP_INF 1.0e20
+
+/** Feasibility tolerance, relative to the magnitude of the bound. */
+#define BLIS_PROP_TOL 1.0e-6
+
+/** Continuous bounds are only tightened by at least this relative amount,
+    and never to a value larger than BLIS_PROP_MAX_BOUND. */
+#define BLIS_PROP_MIN_GAIN 1.0e-3
+#define BLIS_PROP_MAX_BOUND 1.0e9
+
+/** Compute activities from scratch after this many setBounds(). */
+#define BLIS_PROP_RECOMPUTE 1000
+
+//#############################################################################
+
+BlisPropagator::BlisPropagator(const CoinPackedMatrix &rowMatrix,
+                               const CoinPackedMatrix &colMatrix,
+                               const double *rowLower,
+                               const double *rowUpper,
+                               const char *colType,
+                               const double *colLower,
+                               const double *colUpper)
+    :
+    byRow_(rowMatrix),
+    byCol_(colMatrix),
+    numIncremental_(0)
+{
+    int i, j;
+
+    assert(!byRow_.isColOrdered() && byCol_.isColOrdered());
+
+    numRows_ = byRow_.getNumRows();
+    numCols_ = byRow_.getNumCols();
+
+    rowLower_ = new double [numRows_];
+    rowUpper_ = new double [numRows_];
+    CoinDisjointCopyN(rowLower, numRows_, rowLower_);
+    CoinDisjointCopyN(rowUpper, numRows_, rowUpper_);
+
+    isInteger_ = new char [numCols_];
+    for (j = 0; j < numCols_; ++j) {
+        isInteger_[j] = (colType[j] != 'C');
+    }
+
+    lower_ = new double [numCols_];
+    upper_ = new double [numCols_];
+    CoinDisjointCopyN(colLower, numCols_, lower_);
+    CoinDisjointCopyN(colUpper, numCols_, upper_);
+
+    minAct_ = new double [numRows_];
+    maxAct_ = new double [numRows_];
+    minInf_ = new int [numRows_];
+    maxInf_ = new int [numRows_];
+
+    rowQueued_ = new char [numRows_];
+    lowerMark_ = new char [numCols_];
+    upperMark_ = new char [numCols_];
+    CoinZeroN(lowerMark_, numCols_);
+    CoinZeroN(upperMark_, numCols_);
+
+    computeActivities();
+
+    // The first propagation looks at every row.
+    rowQueue_.reserve(numRows_);
+    for (i = 0; i < numRows_; ++i) {
+        rowQueued_[i] = 1;
+        rowQueue_.push_back(i);
+    }
+}
+
+//#############################################################################
+
+BlisPropagator::~BlisPropagator()
+{
+    delete [] rowLower_;
+    delete [] rowUpper_;
+    delete [] isInteger_;
+    delete [] lower_;
+    delete [] upper_;
+    delete [] minAct_;
+    delete [] maxAct_;
+    delete [] minInf_;
+    delete [] maxInf_;
+    delete [] rowQueued_;
+    delete [] lowerMark_;
+    delete [] upperMark_;
+}
+
+//#############################################################################
+
+void
+BlisPropagator::computeActivities()
+{
+    int i;
+    CoinBigIndex k;
+
+    const double *elements = byRow_.getElements();
+    const int *indices = byRow_.getIndices();
+    const CoinBigIndex *starts = byRow_.getVectorStarts();
+    const int *lengths = byRow_.getVectorLengths();
+
+    CoinZeroN(minAct_, numRows_);
+    CoinZeroN(maxAct_, numRows_);
+    CoinZeroN(minInf_, numRows_);
+    CoinZeroN(maxInf_, numRows_);
+
+    for (i = 0; i < numRows_; ++i) {
+        for (k = starts[i]; k < starts[i] + lengths[i]; ++k) {
+            int j = indices[k];
+            updateActivity(i, elements[k], lower_[j], upper_[j], 1);
+        }
+    }
+}
+
+//#############################################################################
+
+void
+BlisPropagator::updateActivity(int i, double a, double l, double u, int sign)
+{
+    if (a == 0.0) return;
+
+    double minBound = (a > 0.0) ? l : u;
+    double maxBound = (a > 0.0) ? u : l;
+
+    if (fabs(minBound) >= BLIS_PROP_INF) {
+        minInf_[i] += sign;
+    }
+    else {
+        minAct_[i] += sign * a * minBound;
+    }
+
+    if (fabs(maxBound) >= BLIS_PROP_INF) {
+        maxInf_[i] += sign;
+    }
+    else {
+        maxAct_[i] += sign * a * maxBound;
+    }
+}
+
+//#############################################################################
+
+void
+BlisPropagator::changeBounds(int j, double l, double u)
+{
+    CoinBigIndex k;
+
+    const double *elements = byCol_.getElements();
+    const int *indices = byCol_.getIndices();
+    const CoinBigIndex start = byCol_.getVectorStarts()[j];
+    const CoinBigIndex end = start + byCol_.getVectorLengths()[j];
+
+    for (k = start; k < end; ++k) {
+        int i = indices[k];
+        updateActivity(i, elements[k], lower_[j], upper_[j], -1);
+        updateActivity(i, elements[k], l, u, 1);
+        if (!rowQueued_[i]) {
+            rowQueued_[i] = 1;
+            rowQueue_.push_back(i);
+        }
+    }
+
+    lower_[j] = l;
+    upper_[j] = u;
+}
+
+//#############################################################################
+
+void
+BlisPropagator::setBounds(const double *colLower, const double *colUpper)
+{
+    int j;
+    int numDiff = 0;
+
+    clearChanges();
+
+    for (j = 0; j < numCols_; ++j) {
+        if (colLower[j] != lower_[j] || colUpper[j] != upper_[j]) {
+            ++numDiff;
+        }
+    }
+
+    if (numDiff == 0) return;
+
+    if (++numIncremental_ >= BLIS_PROP_RECOMPUTE || numDiff > numCols_ / 2) {
+        // Recompute, which also removes round off accumulated so far.
+        numIncremental_ = 0;
+        CoinDisjointCopyN(colLower, numCols_, lower_);
+        CoinDisjointCopyN(colUpper, numCols_, upper_);
+        computeActivities();
+        rowQueue_.clear();
+        for (int i = 0; i < numRows_; ++i) {
+            rowQueued_[i] = 1;
+            rowQueue_.push_back(i);
+        }
+        return;
+    }
+
+    for (j = 0; j < numCols_; ++j) {
+        if (colLower[j] != lower_[j] || colUpper[j] != upper_[j]) {
+            changeBounds(j, colLower[j], colUpper[j]);
+        }
+    }
+}
+
+//#############################################################################
+
+bool
+BlisPropagator::tightenLower(int j, double value)
+{
+    if (value <= lower_[j]) return false;
+
+    changeBounds(j, value, upper_[j]);
+    if (!lowerMark_[j]) {
+        lowerMark_[j] = 1;
+        changedLower_.push_back(j);
+    }
+    return true;
+}
+
+//#############################################################################
+
+bool
+BlisPropagator::tightenUpper(int j, double value)
+{
+    if (value >= upper_[j]) return false;
+
+    changeBounds(j, lower_[j], value);
+    if (!upperMark_[j]) {
+        upperMark_[j] = 1;
+        changedUpper_.push_back(j);
+    }
+    return true;
+}
+
+//#############################################################################
+
+void
+BlisPropagator::clearChanges()
+{
+    size_t k;
+    for (k = 0; k < changedLower_.size(); ++k) {
+        lowerMark_[changedLower_[k]] = 0;
+    }
+    for (k = 0; k < changedUpper_.size(); ++k) {
+        upperMark_[changedUpper_[k]] = 0;
+    }
+    changedLower_.clear();
+    changedUpper_.clear();
+}
+
+//#############################################################################
+
+bool
+BlisPropagator::propagateRow(int i)
+{
+    const double L = rowLower_[i];
+    const double U = rowUpper_[i];
+    const bool hasLower = (L > -BLIS_PROP_INF);
+    const bool hasUpper = (U < BLIS_PROP_INF);
+
+    //------------------------------------------------------
+    // Infeasible row.
+    //------------------------------------------------------
+
+    if (hasUpper && minInf_[i] == 0 &&
+        minAct_[i] > U + BLIS_PROP_TOL * (1.0 + fabs(U))) {
+        return false;
+    }
+    if (hasLower && maxInf_[i] == 0 &&
+        maxAct_[i] < L - BLIS_PROP_TOL * (1.0 + fabs(L))) {
+        return false;
+    }
+
+    // With two or more infinite contributions nothing can be derived.
+    const bool useUpper = hasUpper && minInf_[i] <= 1;
+    const bool useLower = hasLower && maxInf_[i] <= 1;
+
+    if (!useUpper && !useLower) return true;
+
+    const double *elements = byRow_.getElements();
+    const int *indices = byRow_.getIndices();
+    const CoinBigIndex start = byRow_.getVectorStarts()[i];
+    const CoinBigIndex end = start + byRow_.getVectorLengths()[i];
+
+    for (CoinBigIndex k = start; k < end; ++k) {
+        const double a = elements[k];
+        const int j = indices[k];
+        if (a == 0.0 || upper_[j] <= lower_[j]) continue;
+
+        double newLb = -COIN_DBL_MAX;
+        double newUb = COIN_DBL_MAX;
+
+        //--------------------------------------------------
+        // a x_j <= U - (min activity of the other columns).
+        //--------------------------------------------------
+
+        if (useUpper) {
+            double own = (a > 0.0) ? lower_[j] : upper_[j];
+            bool ownInf = (fabs(own) >= BLIS_PROP_INF);
+            if (ownInf || minInf_[i] == 0) {
+                double residual = ownInf ? minAct_[i] : minAct_[i] - a * own;
+                if (!ownInf || minInf_[i] == 1) {
+                    double bound = (U - residual) / a;
+                    if (a > 0.0) newUb = bound;
+                    else newLb = bound;
+                }
+            }
+        }
+
+        //--------------------------------------------------
+        // a x_j >= L - (max activity of the other columns).
+        //--------------------------------------------------
+
+        if (useLower) {
+            double own = (a > 0.0) ? upper_[j] : lower_[j];
+            bool ownInf = (fabs(own) >= BLIS_PROP_INF);
+            if (ownInf || maxInf_[i] == 0) {
+                double residual = ownInf ? maxAct_[i] : maxAct_[i] - a * own;
+                if (!ownInf || maxInf_[i] == 1) {
+                    double bound = (L - residual) / a;
+                    if (a > 0.0) newLb = CoinMax(newLb, bound);
+                    else newUb = CoinMin(newUb, bound);
+                }
+            }
+        }
+
+        //--------------------------------------------------
+        // Round and filter.
+        //--------------------------------------------------
+
+        double lb = lower_[j];
+        double ub = upper_[j];
+
+        if (isInteger_[j]) {
+            if (newLb > -COIN_DBL_MAX) newLb = ceil(newLb - BLIS_PROP_TOL);
+            if (newUb < COIN_DBL_MAX) newUb = floor(newUb + BLIS_PROP_TOL);
+            if (newLb < lb + 0.5) newLb = lb;
+            if (newUb > ub - 0.5) newUb = ub;
+        }
+        else {
+            if (fabs(newLb) >= BLIS_PROP_MAX_BOUND ||
+                (lb > -BLIS_PROP_INF &&
+                 newLb < lb + BLIS_PROP_MIN_GAIN * CoinMax(1.0, fabs(lb)))) {
+                newLb = lb;
+            }
+            if (fabs(newUb) >= BLIS_PROP_MAX_BOUND ||
+                (ub < BLIS_PROP_INF &&
+                 newUb > ub - BLIS_PROP_MIN_GAIN * CoinMax(1.0, fabs(ub)))) {
+                newUb = ub;
+            }
+        }
+
+        if (newLb == lb && newUb == ub) continue;
+
+        if (newLb > newUb) {
+            if (newLb > newUb + BLIS_PROP_TOL * (1.0 + fabs(newUb))) {
+                return false;
+            }
+            // Crossed within tolerance, fix at the old bound.
+            if (newLb == lb) newUb = lb;
+            else newLb = newUb;
+        }
+
+        if (newLb > lb) tightenLower(j, newLb);
+        if (newUb < ub) tightenUpper(j, newUb);
+    }
+
+    return true;
+}
+
+//#############################################################################
+
+int
+BlisPropagator::propagate(int maxPasses)
+{
+    size_t k;
+    int pass;
+    bool feasible = true;
+
+    size_t numChanges = changedLower_.size() + changedUpper_.size();
+
+    std::vector<int> rows;
+
+    for (pass = 0; pass < maxPasses && !rowQueue_.empty(); ++pass) {
+        // Rows queued during this pass are done in the next one. A row
+        // stays marked while it waits, so it is queued once.
+        rows.swap(rowQueue_);
+        rowQueue_.clear();
+
+        for (k = 0; k < rows.size(); ++k) {
+            int i = rows[k];
+            if (feasible) {
+                feasible = propagateRow(i);
+            }
+            rowQueued_[i] = 0;
+        }
+
+        if (!feasible) break;
+    }
+
+    // Anything left is dropped, propagation is a heuristic.
+    for (k = 0; k < rowQueue_.size(); ++k) {
+        rowQueued_[rowQueue_[k]] = 0;
+    }
+    rowQueue_.clear();
+
+    if (!feasible) return -1;
+
+    return static_cast<int>(changedLower_.size() + changedUpper_.size() -
+                            numChanges);
+}
+
+//#############################################################################
@@ -0,0 +1,145 @@
+/*===========================================================================*
+ * This file is part of the Bcps Linear Solver (BLIS).                       *
+ *                                                                           *
+ * BLIS is distributed under the Eclipse Public License as part of the       *
+ * COIN-OR repository (http://www.coin-or.org).                              *
+ *                                                                           *
+ * Authors:                                                                  *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *                                                                           *
+ * Conceptual Design:                                                        *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *          Laszlo Ladanyi, IBM T.J. Watson Research Center                  *
+ *          Matthew Saltzman, Clemson University                             *
+ *                                                                           *
+ *                                                                           *
+ * Copyright (C) 2001-2017, Lehigh University, Yan Xu, and Ted Ralphs.       *
+ * All Rights Reserved.                                                      *
+ *===========================================================================*/
+
+#ifndef BlisPropagator_h_
+#define BlisPropagator_h_
+
+#include <vector>
+
+#include "CoinPackedMatrix.hpp"
+
+//#############################################################################
+
+/** Domain propagation over the core rows.
+    The propagator keeps the column bounds of the node being processed and
+    the minimum and maximum activity of every core row under those bounds.
+    Activities are updated incrementally when a bound changes, and rows
+    touched by a change are queued. propagate() derives implied column
+    bounds from the queued rows until nothing changes, or it finds a row
+    that can not be satisfied.
+*/
+class BlisPropagator {
+ private:
+    /** Illegal copy constructor. */
+    BlisPropagator(const BlisPropagator &);
+
+    /** Illegal assignment operator. */
+    BlisPropagator & operator=(const BlisPropagator &);
+
+    int numCols_;
+    int numRows_;
+
+    /** Core matrix by row and by column, owned by the model. */
+    const CoinPackedMatrix &byRow_;
+    const CoinPackedMatrix &byCol_;
+
+    /** Core row bounds. */
+    double *rowLower_;
+    double *rowUpper_;
+
+    /** 1 if column is integer. */
+    char *isInteger_;
+
+    /** Current column bounds. */
+    double *lower_;
+    double *upper_;
+
+    /** Finite part of row activity bounds and the number of infinite
+        contributions to them. */
+    double *minAct_;
+    double *maxAct_;
+    int *minInf_;
+    int *maxInf_;
+
+    /** Rows waiting to be propagated. */
+    std::vector<int> rowQueue_;
+    char *rowQueued_;
+
+    /** Columns whose bounds propagation tightened since the last
+        setBounds() or clearChanges(). */
+    std::vector<int> changedLower_;
+    std::vector<int> changedUpper_;
+    char *lowerMark_;
+    char *upperMark_;
+
+    /** Number of setBounds() calls since activities were computed from
+        scratch. Limits round off of the incremental updates. */
+    int numIncremental_;
+
+    /** Compute all row activities from the current bounds. */
+    void computeActivities();
+
+    /** Add (sign 1) or remove (sign -1) the contribution of a column with
+        coefficient a and bounds [l, u] to the activities of row i. */
+    void updateActivity(int i, double a, double l, double u, int sign);
+
+    /** Change the bounds of column j, update activities and queue rows. */
+    void changeBounds(int j, double l, double u);
+
+    /** Derive bounds from row i. Return false if the row is infeasible. */
+    bool propagateRow(int i);
+
+ public:
+    /** Useful constructor. rowMatrix and colMatrix are the core matrix
+        ordered by row and by column; they are not copied and must outlive
+        the propagator. */
+    BlisPropagator(const CoinPackedMatrix &rowMatrix,
+                   const CoinPackedMatrix &colMatrix,
+                   const double *rowLower,
+                   const double *rowUpper,
+                   const char *colType,
+                   const double *colLower,
+                   const double *colUpper);
+
+    /** Destructor. */
+    ~BlisPropagator();
+
+    /** Install the bounds of a node. Only the columns that differ from
+        the current bounds update the activities. */
+    void setBounds(const double *colLower, const double *colUpper);
+
+    /** Tighten a bound from outside, e.g. by reduced cost fixing. Return
+        true if the bound changed. */
+    bool tightenLower(int j, double value);
+    bool tightenUpper(int j, double value);
+
+    /** Propagate queued rows for at most maxPasses passes. Return -1 if
+        the bounds are infeasible, otherwise the number of bound changes. */
+    int propagate(int maxPasses);
+
+    /** True if some rows are waiting to be propagated. */
+    bool hasPending() const { return !rowQueue_.empty(); }
+
+    /** Current column bounds. */
+    const double *getColLower() const { return lower_; }
+    const double *getColUpper() const { return upper_; }
+
+    /** Columns with bounds tightened by tighten*() or propagate(). */
+    const std::vector<int> &getChangedLower() const { return changedLower_; }
+    const std::vector<int> &getChangedUpper() const { return changedUpper_; }
+
+    /** Forget the changed columns. */
+    void clearChanges();
+};
+
+#endif
@@ -46,17 +46,33 @@ class BlisSolution : public BcpsSolution {
 	BcpsSolution(s, values, objValue)
 	{}
 
+    /** Useful constructor. Drop entries not larger than zeroTol in absolute
+        value, store sparse if smaller. */
+    BlisSolution(int s, const double *values, double objValue, double zeroTol)
+	:
+	BcpsSolution(s, values, objValue, zeroTol)
+	{}
+
+    /** Sparse constructor. */
+    BlisSolution(int s, int num, const int *indices, const double *values,
+                 double objValue)
+	:
+	BcpsSolution(s, num, indices, values, objValue)
+	{}
+
     /** Destructor. */
     virtual ~BlisSolution() { }
+
+    /** Return a sparse copy with the entries larger than etol in absolute
+        value. */
     virtual BcpsSolution * selectNonzeros(const double etol=1e-5) const {
-        std::cerr << "Not implemented yet!" << std::endl;
-        throw std::exception();
-        return NULL;
+        return select(etol, false);
     }
+
+    /** Return a sparse copy with the entries more than etol away from an
+        integer. */
     virtual BcpsSolution * selectFractional(const double etol=1e-5) const {
-        std::cerr << "Not implemented yet!" << std::endl;
-        throw std::exception();
-        return NULL;
+        return select(etol, true);
     }
 
     ///@name Encode and Decode functions
@@ -127,6 +143,22 @@ class BlisSolution : public BcpsSolution {
         return status;
     }
     //@}
+
+ private:
+
+    /** Create the sparse copy for selectNonzeros and selectFractional. */
+    BlisSolution * select(double etol, bool fractional) const {
+        int length = numElements_ > 0 ? numElements_ : 1;
+        int * indices = new int [length];
+        double * values = new double [length];
+        int num = selectEntries(etol, fractional, indices, values);
+        BlisSolution * sol = new BlisSolution(size_, num, indices, values,
+                                              quality_);
+        sol->setBroker(broker_);
+        delete [] indices;
+        delete [] values;
+        return sol;
+    }
 };
 
 //#############################################################################
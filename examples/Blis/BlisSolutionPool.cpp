@@ -0,0 +1,153 @@
+/*===========================================================================*
+ * This file is part of the Bcps Linear Solver (BLIS).                       *
+ *                                                                           *
+ * BLIS is distributed under the Eclipse Public License as part of the       *
+ * COIN-OR repository (http://www.coin-or.org).                              *
+ *                                                                           *
+ * Authors:                                                                  *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *                                                                           *
+ * Conceptual Design:                                                        *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *          Laszlo Ladanyi, IBM T.J. Watson Research Center                  *
+ *          Matthew Saltzman, Clemson University                             *
+ *                                                                           *
+ *                                                                           *
+ * Copyright (C) 2001-2017, Lehigh University, Yan Xu, and Ted Ralphs.       *
+ * All Rights Reserved.                                                      *
+ *===========================================================================*/
+
+#include <cmath>
+#include <vector>
+
+#include "BlisSolution.h"
+#include "BlisSolutionPool.h"
+
+//#############################################################################
+
+BlisSolutionPool::BlisSolutionPool(int maxSize)
+    :
+    maxSize_(maxSize),
+    numDuplicates_(0)
+{}
+
+//#############################################################################
+
+BlisSolutionPool::~BlisSolutionPool()
+{
+    for (size_t k = 0; k < elite_.size(); ++k) {
+        delete elite_[k].second;
+    }
+}
+
+//#############################################################################
+
+/** FNV-1a over the index and the rounded value of each nonzero. */
+unsigned long
+BlisSolutionPool::hashKey(int size, const double *x) const
+{
+    unsigned long key = 2166136261UL;
+    for (int j = 0; j < size; ++j) {
+        double rounded = floor(x[j] * 1.0e6 + 0.5);
+        if (rounded == 0.0) {
+            continue;
+        }
+        long value = static_cast<long>(rounded);
+        key = (key ^ static_cast<unsigned long>(j)) * 16777619UL;
+        key = (key ^ static_cast<unsigned long>(value)) * 16777619UL;
+    }
+    return key;
+}
+
+//#############################################################################
+
+/** Objective values are the same up to the hash rounding. */
+static bool
+sameValue(double a, double b)
+{
+    return fabs(a - b) <= 1.0e-6 * (1.0 + fabs(b));
+}
+
+//#############################################################################
+
+/** Different solutions can share a key, so the value must match as well.
+    If the earlier solution is still among the elite, its entries are
+    compared; one that was not kept is recognized by key and value only. */
+bool
+BlisSolutionPool::isDuplicate(unsigned long key, int size, const double *x,
+                              double value) const
+{
+    std::multimap<unsigned long, double>::const_iterator pos, end;
+    for (pos = keys_.lower_bound(key), end = keys_.upper_bound(key);
+         pos != end; ++pos) {
+        if (sameValue(pos->second, value)) {
+            break;
+        }
+    }
+    if (pos == end) {
+        return false;
+    }
+
+    std::vector<double> stored(size);
+    bool kept = false;
+    for (size_t k = 0; k < elite_.size(); ++k) {
+        const BlisSolution *sol = elite_[k].second;
+        if (!sameValue(elite_[k].first, value) || sol->getSize() != size) {
+            continue;
+        }
+        sol->getDenseValues(&stored[0]);
+        if (hashKey(size, &stored[0]) != key) {
+            continue;
+        }
+        kept = true;
+        int j = 0;
+        while (j < size && fabs(stored[j] - x[j]) <= 1.0e-6) {
+            ++j;
+        }
+        if (j == size) {
+            return true;
+        }
+    }
+
+    return !kept;
+}
+
+//#############################################################################
+
+bool
+BlisSolutionPool::add(int size, const double *x, double value)
+{
+    unsigned long key = hashKey(size, x);
+    if (isDuplicate(key, size, x, value)) {
+        ++numDuplicates_;
+        return false;
+    }
+    keys_.insert(std::make_pair(key, value));
+
+    if (maxSize_ <= 0) {
+        return true;
+    }
+    if (static_cast<int>(elite_.size()) == maxSize_) {
+        if (value >= elite_.back().first) {
+            return true;
+        }
+        delete elite_.back().second;
+        elite_.pop_back();
+    }
+
+    // Insert by value, after those that are as good.
+    size_t pos = elite_.size();
+    while (pos > 0 && elite_[pos - 1].first > value) {
+        --pos;
+    }
+    BlisSolution *sol = new BlisSolution(size, x, value, 1.0e-15);
+    elite_.insert(elite_.begin() + pos, std::make_pair(value, sol));
+
+    return true;
+}
+
+//#############################################################################
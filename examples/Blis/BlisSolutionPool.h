@@ -0,0 +1,96 @@
+/*===========================================================================*
+ * This file is part of the Bcps Linear Solver (BLIS).                       *
+ *                                                                           *
+ * BLIS is distributed under the Eclipse Public License as part of the       *
+ * COIN-OR repository (http://www.coin-or.org).                              *
+ *                                                                           *
+ * Authors:                                                                  *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *                                                                           *
+ * Conceptual Design:                                                        *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *          Laszlo Ladanyi, IBM T.J. Watson Research Center                  *
+ *          Matthew Saltzman, Clemson University                             *
+ *                                                                           *
+ *                                                                           *
+ * Copyright (C) 2001-2017, Lehigh University, Yan Xu, and Ted Ralphs.       *
+ * All Rights Reserved.                                                      *
+ *===========================================================================*/
+
+#ifndef BlisSolutionPool_h_
+#define BlisSolutionPool_h_
+
+#include <map>
+#include <utility>
+#include <vector>
+
+class BlisSolution;
+
+//#############################################################################
+
+/** Solutions found in this process, before they go to the broker.
+    Each solution is hashed over its support and its values rounded to
+    1.0e-6, so a solution that was offered before is recognized and need
+    not be sent again. A key is only taken as a duplicate when the
+    objective values match too, and the entries are compared when the
+    earlier solution is still kept. The best maxSize distinct solutions
+    are kept (in lp column space, stored sparse when smaller) for
+    solution-guided heuristics. All values are in minimization form.
+*/
+class BlisSolutionPool {
+
+ private:
+
+    /** Disable copy and assignment. */
+    BlisSolutionPool(const BlisSolutionPool &);
+    BlisSolutionPool & operator=(const BlisSolutionPool &);
+
+    /** Maximum number of elite solutions kept. */
+    int maxSize_;
+
+    /** Hash keys of all solutions offered, with their values. */
+    std::multimap<unsigned long, double> keys_;
+
+    /** Elite solutions with their values, best first. */
+    std::vector<std::pair<double, BlisSolution *> > elite_;
+
+    /** Number of duplicates offered. */
+    int numDuplicates_;
+
+    /** Compute the hash key of a solution. */
+    unsigned long hashKey(int size, const double *x) const;
+
+    /** Return true if a solution with the given key was offered before. */
+    bool isDuplicate(unsigned long key, int size, const double *x,
+                     double value) const;
+
+ public:
+
+    /** Useful constructor. */
+    BlisSolutionPool(int maxSize);
+
+    /** Destructor. */
+    ~BlisSolutionPool();
+
+    /** Offer a solution of the given value. Return false if it was offered
+        before, in which case it should not be passed on. */
+    bool add(int size, const double *x, double value);
+
+    /** Get the number of elite solutions. */
+    int getNumSolutions() const { return static_cast<int>(elite_.size()); }
+
+    /** Get the value of the k-th best solution. */
+    double getValue(int k) const { return elite_[k].first; }
+
+    /** Get the k-th best solution. */
+    const BlisSolution * getSolution(int k) const { return elite_[k].second; }
+
+    /** Get the number of duplicates dropped. */
+    int getNumDuplicates() const { return numDuplicates_; }
+};
+
+#endif
@@ -21,12 +21,15 @@
  * All Rights Reserved.                                                      *
  *===========================================================================*/
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <utility>
 #include <cmath>
+#include <map>
 #include <vector>
 
+#include "CoinTime.hpp"
 #include "CoinUtility.hpp"
 #include "OsiRowCut.hpp"
 #include "OsiColCut.hpp"
@@ -43,17 +46,18 @@
 #include "BlisBranchObjectInt.h"
 #include "BlisConstraint.h"
 #include "BlisHelp.h"
+#include "BlisHeurWorker.h"
 #include "BlisTreeNode.h"
 #include "BlisModel.h"
 #include "BlisNodeDesc.h"
 #include "BlisModel.h"
 #include "BlisObjectInt.h"
 #include "BlisParams.h"
+#include "BlisPropagator.h"
 #include "BlisSolution.h"
+#include "BlisSolutionPool.h"
 //#include "BlisVariable.h"
 
-#define REMOVE_SLACK 1
-
 //#############################################################################
 
 // define structs that will be used in creating nodes.
@@ -67,6 +71,48 @@ struct Bound {
   SparseVector upper;
 };
 
+// Set the entry of the given position in a field list, append it if the
+// position is not modified yet.
+static void setFieldEntry(BcpsFieldListMod<double> & field,
+                          int index,
+                          double value) {
+  int k;
+  for (k = 0; k < field.numModify; ++k) {
+    if (field.posModify[k] == index) {
+      field.entries[k] = value;
+      return;
+    }
+  }
+  int * pos = new int[field.numModify + 1];
+  double * entries = new double[field.numModify + 1];
+  std::copy(field.posModify, field.posModify + field.numModify, pos);
+  std::copy(field.entries, field.entries + field.numModify, entries);
+  pos[field.numModify] = index;
+  entries[field.numModify] = value;
+  delete[] field.posModify;
+  delete[] field.entries;
+  field.posModify = pos;
+  field.entries = entries;
+  ++field.numModify;
+}
+
+
+BlisTreeNode::~BlisTreeNode()
+{
+    //delete constraintPool_;
+    //delete variablePool_;
+
+    if (poolTracked_) {
+        BlisModel *model = dynamic_cast<BlisModel*>(broker_->getModel());
+        model->removePoolNode(this, false);
+    }
+
+    for (size_t k = 0; k < diveSiblings_.size(); ++k) {
+        delete diveSiblings_[k].first;
+    }
+}
+
+//#############################################################################
 
 AlpsTreeNode*
 BlisTreeNode::createNewTreeNode(AlpsNodeDesc *&desc) const
@@ -86,6 +132,13 @@ BlisTreeNode::createNewTreeNode(AlpsNodeDesc *&desc) const
 
     desc = NULL;
 
+    // Count it against the node memory limit while it waits in the pool.
+    if (broker_) {
+        BlisModel *model = dynamic_cast<BlisModel*>(broker_->getModel());
+        node->setBroker(broker_);
+        model->addPoolNode(node);
+    }
+
     return node;
 }
 
@@ -104,6 +157,9 @@ BlisTreeNode::process(bool isRoot, bool rampUp)
   double sense = model->BlisPar()->entry(BlisParams::objSense);
   cutoff = sense*cutoff;
   cutoff = CoinMin(cutoff, broker()->getIncumbentValue());
+  // a cutoff shared by another process may not be in the broker yet,
+  // nodes pruned by it must be fathomed here too
+  cutoff = CoinMin(cutoff, model->getCutoff());
   // check if this can be fathomed
   double rel_gap_limit = model->BlisPar()->entry(BlisParams::optimalRelGap);
   double abs_gap_limit = model->BlisPar()->entry(BlisParams::optimalAbsGap);
@@ -115,6 +171,12 @@ BlisTreeNode::process(bool isRoot, bool rampUp)
   }
   if (status==AlpsNodeStatusCandidate ||
       status==AlpsNodeStatusEvaluated) {
+    // The node leaves the pool, bring its description back into memory.
+    model->removePoolNode(this);
+    model->checkPoolMemory();
+    // count processed nodes, heuristics and cut generators are
+    // scheduled by it
+    model->addNumNodes();
     boundingLoop();
   }
   else if (status==AlpsNodeStatusBranched ||
@@ -138,6 +200,15 @@ void BlisTreeNode::boundingLoop() {
   BcpsVariablePool * variablePool = new BcpsVariablePool();
   installSubProblem();
 
+  // number of constraint generation rounds allowed at this node
+  numConPassesLeft_ = 0;
+  if (model->useCons() > -2 &&
+      (broker()->getPhase() != AlpsPhaseRampup ||
+       model->BlisPar()->entry(BlisParams::cutDuringRampup))) {
+    numConPassesLeft_ = model->BlisPar()->entry(BlisParams::cutPass);
+  }
+  bool removeSlack = model->BlisPar()->entry(BlisParams::removeSlackCons);
+
   while (keepBounding) {
     keepBounding = false;
     // solve subproblem corresponds to this node
@@ -165,6 +236,13 @@ void BlisTreeNode::boundingLoop() {
       setStatus(AlpsNodeStatusFathomed);
       break;
     }
+    // fix columns by reduced cost, this may prove that the subtree
+    // has no better solution
+    if (subproblem_status==BcpsSubproblemStatusOptimal &&
+        reducedCostFix(model)==BLIS_LP_PRIMAL_INF) {
+      setStatus(AlpsNodeStatusFathomed);
+      break;
+    }
     // call heuristics to search for a solution
     callHeuristics();
 
@@ -178,6 +256,10 @@ void BlisTreeNode::boundingLoop() {
     }
     else if (keepBounding && genConstraints) {
       generateConstraints(constraintPool);
+      if (removeSlack) {
+        // drop constraints that stayed slack for a while
+        removeSlackConstraints(model);
+      }
       // add constraints to the model
       applyConstraints(constraintPool);
       // clear constraint pool
@@ -199,17 +281,50 @@ void BlisTreeNode::boundingLoop() {
     }
     else if (keepBounding==false && do_branch) {
       // branch
+      // children should not inherit constraints that stayed slack, drop
+      // them while the row activities still match the lp solution. The
+      // lp is resolved so that branching sees a current solution.
+      if (removeSlack && removeSlackConstraints(model) > 0) {
+        model->solver()->resolve();
+      }
       BcpsBranchStrategy * branchStrategy = model->branchStrategy();
-      branchStrategy->createCandBranchObjects(this);
-      // prepare this node for branching, bookkeeping for differencing.
-      // call pregnant setting routine
-      processSetPregnant();
+      int branchStatus = branchStrategy->createCandBranchObjects(this);
+      if (branchStatus == BLIS_BRANCH_FATHOM) {
+        // strong branching found no child worth keeping.
+        setStatus(AlpsNodeStatusFathomed);
+      }
+      else if (branchStatus == BLIS_BRANCH_TIGHTEN) {
+        // strong branching dropped children, this node is the other one
+        // now, bound it again.
+        keepBounding = true;
+      }
+      else if (diveInPlace(model)) {
+        // the lp holds the preferred child now, bound it in this node.
+        keepBounding = true;
+      }
+      else {
+        // prepare this node for branching, bookkeeping for differencing.
+        // call pregnant setting routine
+        processSetPregnant();
+      }
     }
     else {
       std::cerr << "This should not happen!" << std::endl;
       throw std::exception();
     }
   }
+  if (numDives_ > 0 && getStatus() != AlpsNodeStatusPregnant) {
+    // the dive ended without branching. the children it left behind
+    // still have to be searched, and so does the dive unless it was
+    // fathomed.
+    if (getStatus() != AlpsNodeStatusFathomed) {
+      BlisNodeDesc * dive = createDiveChild(model, diveLower_, diveUpper_);
+      diveSiblings_.push_back(CoinMakeTriple(static_cast<AlpsNodeDesc*>(dive),
+                                             AlpsNodeStatusCandidate,
+                                             quality_));
+    }
+    processSetPregnant();
+  }
   delete constraintPool;
   delete variablePool;
 }
@@ -254,7 +369,18 @@ BlisTreeNode::branch()
   //std::cout << "abs " << abs_gap << " limit " << abs_gap_limit << std::endl;
   //std::cout << "rel " << rel_gap << " limit " << rel_gap_limit << std::endl;
   if (rel_gap_limit>rel_gap || abs_gap_limit>abs_gap) {
-    setStatus(AlpsNodeStatusFathomed);
+    // the children left behind by a dive have their own bounds.
+    if (diveSiblings_.empty()) {
+      setStatus(AlpsNodeStatusFathomed);
+    }
+    takeDiveSiblings(res);
+    return res;
+  }
+
+  // a dive that ended without branching only has the children it left
+  // behind.
+  if (branchObject() == NULL && !diveSiblings_.empty()) {
+    takeDiveSiblings(res);
     return res;
   }
 
@@ -271,11 +397,6 @@ BlisTreeNode::branch()
   int branch_var = branch_object->index();
   double branch_value = branch_object->value();
 
-  // compute child nodes' warm start basis
-  CoinWarmStartBasis * child_ws;
-  child_ws = (getDesc()->getBasis()==0) ? 0 :
-    new CoinWarmStartBasis(*getDesc()->getBasis());
-
   // create new node descriptions
   BlisNodeDesc * down_node = new BlisNodeDesc(model);
   down_node->setBroker(broker_);
@@ -286,36 +407,33 @@ BlisTreeNode::branch()
     // == copy description of this node to the down node
     copyFullNode(down_node);
     // == update the branching variable hard bounds for the down node
-    down_node->vars()->ubHard.entries[branch_var] =
-      branch_object->ubDownBranch();
+    setFieldEntry(down_node->vars()->ubHard, branch_var,
+                  branch_object->ubDownBranch());
 
     // Up Node
     // == copy description of this node to up node
     copyFullNode(up_node);
     // == update the branching variable hard bounds for the up node
-    up_node->vars()->lbHard.entries[branch_var] =
-      branch_object->lbUpBranch();
+    setFieldEntry(up_node->vars()->lbHard, branch_var,
+                  branch_object->lbUpBranch());
   }
   else {
     // Store node description relative to the parent.
-    // We need to add a hard bound for the branching variable.
-
-    double ub_down_branch = branch_object->ubDownBranch();
-    double lb_up_branch = branch_object->lbUpBranch();
-    double lb = model->getVariables()[branch_var]->getLbHard();
-    double ub = model->getVariables()[branch_var]->getUbHard();
-    down_node->setVarHardBound(1,
-                             &branch_var,
-                             &lb,
-                             1,
-                             &branch_var,
-                             &ub_down_branch);
-    up_node->setVarHardBound(1,
-                             &branch_var,
-                             &lb_up_branch,
-                             1,
-                             &branch_var,
-                             &ub);
+    // We need to add a hard bound for the branching variable, and for
+    // the variables a dive in place changed.
+
+    std::map<int, double> lower(diveLower_);
+    std::map<int, double> upper(diveUpper_);
+    if (lower.find(branch_var) == lower.end()) {
+      lower[branch_var] = model->getVariables()[branch_var]->getLbHard();
+      upper[branch_var] = model->getVariables()[branch_var]->getUbHard();
+    }
+    std::map<int, double> down_upper(upper);
+    down_upper[branch_var] = branch_object->ubDownBranch();
+    setChildBounds(down_node, lower, down_upper);
+    std::map<int, double> up_lower(lower);
+    up_lower[branch_var] = branch_object->lbUpBranch();
+    setChildBounds(up_node, up_lower, upper);
   }
 
   // Down Node
@@ -323,26 +441,176 @@ BlisTreeNode::branch()
   down_node->setBranchedDir(-1);
   down_node->setBranchedInd(branch_object->index());
   down_node->setBranchedVal(branch_value);
-  // == set warm start basis for the down node.
-  down_node->setBasis(child_ws);
+  // == share warm start basis of this node with the down node.
+  if (getDesc()->getSharedBasis()) {
+    down_node->setSharedBasis(getDesc()->getSharedBasis()->share());
+  }
   // Up Node
   // == set other relevant fields of up node
   up_node->setBranchedDir(1);
   up_node->setBranchedInd(branch_object->index());
   up_node->setBranchedVal(branch_value);
-  // == set warm start basis for the up node.
-  up_node->setBasis(child_ws);
+  // == share warm start basis of this node with the up node.
+  if (getDesc()->getSharedBasis()) {
+    up_node->setSharedBasis(getDesc()->getSharedBasis()->share());
+  }
 
-  // push the down and up nodes.
+  // push the down and up nodes, then the ones a dive left behind.
   res.push_back(CoinMakeTriple(static_cast<AlpsNodeDesc*>(down_node),
                                AlpsNodeStatusCandidate,
                                quality_));
   res.push_back(CoinMakeTriple(static_cast<AlpsNodeDesc*>(up_node),
                                AlpsNodeStatusCandidate,
                                quality_));
+  takeDiveSiblings(res);
   return res;
 }
 
+//#############################################################################
+
+bool BlisTreeNode::diveInPlace(BlisModel *model)
+{
+  if (numDives_ >= model->BlisPar()->entry(BlisParams::diveDepth) ||
+      broker()->getPhase() == AlpsPhaseRampup) {
+    return false;
+  }
+
+  BlisBranchObjectInt const * branch_object =
+    dynamic_cast<BlisBranchObjectInt const *>(branchObject());
+  if (branch_object == NULL) {
+    return false;
+  }
+
+  // stop once the dive used more than its share of the gap between the
+  // bound where it started and the cutoff.
+  if (numDives_ == 0) {
+    diveStartQuality_ = quality_;
+  }
+  else {
+    double cutoff = CoinMin(model->getCutoff(),
+                            broker()->getIncumbentValue());
+    double dive_gap = model->BlisPar()->entry(BlisParams::diveGap);
+    if (cutoff < ALPS_OBJ_MAX &&
+        quality_ - diveStartQuality_ > dive_gap*(cutoff - diveStartQuality_)) {
+      return false;
+    }
+  }
+
+  int branch_var = branch_object->index();
+  double branch_value = branch_object->value();
+  double lb = model->solver()->getColLower()[branch_var];
+  double ub = model->solver()->getColUpper()[branch_var];
+  // go the way the lp solution leans
+  bool up = (branch_value - floor(branch_value) > 0.5);
+
+  // leave the other child behind
+  std::map<int, double> lower(diveLower_);
+  std::map<int, double> upper(diveUpper_);
+  lower[branch_var] = up ? lb : branch_object->lbUpBranch();
+  upper[branch_var] = up ? branch_object->ubDownBranch() : ub;
+  BlisNodeDesc * sibling = createDiveChild(model, lower, upper);
+  diveSiblings_.push_back(CoinMakeTriple(static_cast<AlpsNodeDesc*>(sibling),
+                                         AlpsNodeStatusCandidate,
+                                         quality_));
+
+  // and change the lp to the preferred one
+  diveLower_[branch_var] = up ? branch_object->lbUpBranch() : lb;
+  diveUpper_[branch_var] = up ? ub : branch_object->ubDownBranch();
+  model->solver()->setColBounds(branch_var,
+                                diveLower_[branch_var],
+                                diveUpper_[branch_var]);
+  BlisPropagator * propagator = model->propagator();
+  if (propagator) {
+    propagator->tightenLower(branch_var, diveLower_[branch_var]);
+    propagator->tightenUpper(branch_var, diveUpper_[branch_var]);
+  }
+
+#ifdef BLIS_DEBUG
+  std::cout << "DIVE: node " << index_ << " step " << numDives_
+            << " var " << branch_var << (up ? " up" : " down") << std::endl;
+#endif
+
+  diveDir_ = up ? 1 : -1;
+  diveInd_ = branch_var;
+  diveVal_ = branch_value;
+  diveParentQuality_ = quality_;
+  ++numDives_;
+  clearBranchObject();
+  return true;
+}
+
+//#############################################################################
+
+void BlisTreeNode::setChildBounds(BlisNodeDesc * child,
+                                  const std::map<int, double> & lower,
+                                  const std::map<int, double> & upper) const
+{
+  std::vector<int> lower_ind, upper_ind, soft_lower_ind, soft_upper_ind;
+  std::vector<double> lower_val, upper_val, soft_lower_val, soft_upper_val;
+  std::map<int, double>::const_iterator pos;
+  for (pos = lower.begin(); pos != lower.end(); ++pos) {
+    lower_ind.push_back(pos->first);
+    lower_val.push_back(pos->second);
+  }
+  for (pos = upper.begin(); pos != upper.end(); ++pos) {
+    upper_ind.push_back(pos->first);
+    upper_val.push_back(pos->second);
+  }
+  child->setVarHardBound(static_cast<int>(lower_ind.size()),
+                         lower_ind.empty() ? NULL : &lower_ind[0],
+                         lower_val.empty() ? NULL : &lower_val[0],
+                         static_cast<int>(upper_ind.size()),
+                         upper_ind.empty() ? NULL : &upper_ind[0],
+                         upper_val.empty() ? NULL : &upper_val[0]);
+  if (diveSoftLower_.empty() && diveSoftUpper_.empty()) {
+    return;
+  }
+  for (pos = diveSoftLower_.begin(); pos != diveSoftLower_.end(); ++pos) {
+    soft_lower_ind.push_back(pos->first);
+    soft_lower_val.push_back(pos->second);
+  }
+  for (pos = diveSoftUpper_.begin(); pos != diveSoftUpper_.end(); ++pos) {
+    soft_upper_ind.push_back(pos->first);
+    soft_upper_val.push_back(pos->second);
+  }
+  child->setVarSoftBound(static_cast<int>(soft_lower_ind.size()),
+                         soft_lower_ind.empty() ? NULL : &soft_lower_ind[0],
+                         soft_lower_val.empty() ? NULL : &soft_lower_val[0],
+                         static_cast<int>(soft_upper_ind.size()),
+                         soft_upper_ind.empty() ? NULL : &soft_upper_ind[0],
+                         soft_upper_val.empty() ? NULL : &soft_upper_val[0]);
+}
+
+//#############################################################################
+
+BlisNodeDesc *
+BlisTreeNode::createDiveChild(BlisModel * model,
+                              const std::map<int, double> & lower,
+                              const std::map<int, double> & upper) const
+{
+  BlisNodeDesc * child = new BlisNodeDesc(model);
+  child->setBroker(broker_);
+  setChildBounds(child, lower, upper);
+  return child;
+}
+
+//#############################################################################
+
+void BlisTreeNode::takeDiveSiblings(
+  std::vector< CoinTriple<AlpsNodeDesc*, AlpsNodeStatus, double> > & res)
+{
+  for (size_t k = 0; k < diveSiblings_.size(); ++k) {
+    // the basis of the deepest dive is a good start for all of them
+    BlisNodeDesc * sibling =
+      dynamic_cast<BlisNodeDesc*>(diveSiblings_[k].first);
+    if (getDesc()->getSharedBasis()) {
+      sibling->setSharedBasis(getDesc()->getSharedBasis()->share());
+    }
+    res.push_back(diveSiblings_[k]);
+  }
+  diveSiblings_.clear();
+}
+
 
 // Copies node description of this node to given child node.
 // New node is explicitly stored in the memory (no differencing).
@@ -355,44 +623,48 @@ void BlisTreeNode::copyFullNode(BlisNodeDesc * child_node) const {
   // solver number of columns
   int num_cols = model->solver()->getNumCols();
 
-  // this will keep bound information, lower and upper
-  // it is used for both hard and soft bounds.
+  // this will keep soft bound information, lower and upper.
   Bound bound;
-  bound.lower.ind = new int[num_cols];
-  bound.lower.val = new double[num_cols];
-  bound.upper.ind = new int[num_cols];
-  bound.upper.val = new double[num_cols];
 
   // Hard bounds
-  // == Hard lower bounds
-  std::copy(node_desc->getVars()->lbHard.posModify,
-            node_desc->getVars()->lbHard.posModify + num_cols,
-            bound.lower.ind);
-  std::copy(node_desc->getVars()->lbHard.entries,
-            node_desc->getVars()->lbHard.entries + num_cols,
-            bound.lower.val);
-  // == Hard upper bounds
-  std::copy(node_desc->getVars()->ubHard.posModify,
-            node_desc->getVars()->ubHard.posModify + num_cols,
-            bound.upper.ind);
-  std::copy(node_desc->getVars()->ubHard.entries,
-            node_desc->getVars()->ubHard.entries + num_cols,
-            bound.upper.val);
+  // == Move hard bounds of this node into a shared explicit block once,
+  // children refer to the block instead of copying it.
+  if (node_desc->getSharedHardBounds() == NULL) {
+    double * lower = new double[num_cols];
+    double * upper = new double[num_cols];
+    CoinFillN(lower, num_cols, -ALPS_DBL_MAX);
+    CoinFillN(upper, num_cols, ALPS_DBL_MAX);
+    int k;
+    int num_modify = node_desc->getVars()->lbHard.numModify;
+    for (k = 0; k < num_modify; ++k) {
+      lower[node_desc->getVars()->lbHard.posModify[k]] =
+        node_desc->getVars()->lbHard.entries[k];
+    }
+    num_modify = node_desc->getVars()->ubHard.numModify;
+    for (k = 0; k < num_modify; ++k) {
+      upper[node_desc->getVars()->ubHard.posModify[k]] =
+        node_desc->getVars()->ubHard.entries[k];
+    }
+    node_desc->setSharedHardBounds(new BlisSharedBounds(num_cols,
+                                                        lower,
+                                                        upper));
+    node_desc->setVarHardBound(0, NULL, NULL, 0, NULL, NULL);
+  }
+  child_node->setSharedHardBounds(node_desc->getSharedHardBounds()->share());
 
-  // assign hard bounds for the child node.
-  // this takes ownership of the arrays.
-  child_node->assignVarHardBound(num_cols,
-                                 bound.lower.ind,
-                                 bound.lower.val,
-                                 num_cols,
-                                 bound.upper.ind,
-                                 bound.upper.val);
+  // == Copy changes of this node to the shared block, these are the
+  // branching bounds since ramp-up started.
+  child_node->setVarHardBound(node_desc->getVars()->lbHard.numModify,
+                              node_desc->getVars()->lbHard.posModify,
+                              node_desc->getVars()->lbHard.entries,
+                              node_desc->getVars()->ubHard.numModify,
+                              node_desc->getVars()->ubHard.posModify,
+                              node_desc->getVars()->ubHard.entries);
 
   // Soft bounds.
   // == Soft lower bounds
   // number of entries modified for soft lower bounds
   int sl_num_modify = node_desc->getVars()->lbSoft.numModify;
-  // We can reuse bound here since previos arrays are owned by Bcps.
   bound.lower.ind = new int[sl_num_modify];
   bound.lower.val = new double[sl_num_modify];
   std::copy(node_desc->getVars()->lbSoft.posModify,
@@ -440,7 +712,31 @@ BcpsSubproblemStatus BlisTreeNode::bound()
     }
 #endif
 
+    //------------------------------------------------------
+    // Propagate bound changes first, the lp is not needed
+    // if they are infeasible.
+    //------------------------------------------------------
+
+    BlisPropagator *propagator = model->propagator();
+    if (propagator && propagator->hasPending()) {
+        int numPasses = model->BlisPar()->entry(BlisParams::propagatePass);
+        if (propagator->propagate(numPasses) < 0) {
+#ifdef BLIS_DEBUG
+            std::cout << "BOUND: infeasible by propagation" << std::endl;
+#endif
+            propagator->clearChanges();
+            return BcpsSubproblemStatusPrimalInfeasible;
+        }
+        applyPropagatedBounds(model);
+    }
+
+    // Incumbents from other processes only reach the broker, take them
+    // into the lp cutoff before every solve.
+    model->tightenCutoff(broker()->getIncumbentValue());
+
     model->solver()->resolve();
+    // search lp iterations, the budget of the diving heuristics
+    model->addNumIterations(model->solver()->getIterationCount());
 
     if (model->solver()->isAbandoned()) {
 #ifdef BLIS_DEBUG
@@ -663,6 +959,22 @@ int BlisTreeNode::installSubProblem()
         varHardLB = pathDesc->getVars()->lbHard.entries;
         varHardUB = pathDesc->getVars()->ubHard.entries;
 
+	//--------------------------------------------------
+	// Start from shared explicit hard bounds if any. Nodes
+	// created during rampup store their changes relative to it.
+	//--------------------------------------------------
+
+	BlisSharedBounds *sharedBounds = pathDesc->getSharedHardBounds();
+	if (sharedBounds) {
+	    const double *sharedLB = sharedBounds->getLower();
+	    const double *sharedUB = sharedBounds->getUpper();
+	    numModify = sharedBounds->getSize();
+	    for (k = 0; k < numModify; ++k) {
+		startColLB[k] = std::max(startColLB[k], sharedLB[k]);
+		startColUB[k] = std::min(startColUB[k], sharedUB[k]);
+	    }
+	}
+
 	//--------------------------------------------------
         // Adjust bounds according to hard var lb/ub.
 	// If rampup or explicit, collect hard bounds so far.
@@ -897,8 +1209,27 @@ int BlisTreeNode::installSubProblem()
     // Adjust column bounds in lp solver
     //--------------------------------------------------------
 
-    for(i = 0; i < numCols; ++i) {
-	model->solver()->setColBounds(i, startColLB[i], startColUB[i]);
+    //--------------------------------------------------------
+    // Global bounds from root reduced cost fixing.
+    //--------------------------------------------------------
+
+    const double *globalLB = model->globalVarLB();
+    const double *globalUB = model->globalVarUB();
+    if (globalLB) {
+	for (i = 0; i < numCoreVars; ++i) {
+	    startColLB[i] = std::max(startColLB[i], globalLB[i]);
+	    startColUB[i] = std::min(startColUB[i], globalUB[i]);
+	}
+    }
+
+    model->installColBounds(startColLB, startColUB);
+
+    //--------------------------------------------------------
+    // Propagation continues from the bounds of this node.
+    //--------------------------------------------------------
+
+    if (model->propagator()) {
+        model->propagator()->setBounds(startColLB, startColUB);
     }
 
     //--------------------------------------------------------
@@ -920,18 +1251,9 @@ int BlisTreeNode::installSubProblem()
 #endif
 
     if (numOldCons > 0) {
-	const OsiRowCut ** oldOsiCuts = new const OsiRowCut * [numOldCons];
-	for (k = 0; k < numOldCons; ++k) {
-	    OsiRowCut * acut =
-		BlisConstraintToOsiCut(model->oldConstraints()[k]);
-	    oldOsiCuts[k] = acut;
-	}
-	model->solver()->applyRowCuts(numOldCons, oldOsiCuts);
-	for (k = 0; k < numOldCons; ++k) {
-	    delete oldOsiCuts[k];
-	}
-	delete [] oldOsiCuts;
-	oldOsiCuts = NULL;
+	BlisAddConstraintsToSolver(model->solver(),
+				   numOldCons,
+				   model->oldConstraints());
     }
 
     //--------------------------------------------------------
@@ -943,7 +1265,7 @@ int BlisTreeNode::installSubProblem()
     // Set basis
     //--------------------------------------------------------
 
-    CoinWarmStartBasis *pws = desc->getBasis();
+    CoinWarmStartBasis *pws = desc->createBasis();
 
     if (pws != NULL) {
 	model->solver()->setWarmStart(pws);
@@ -970,6 +1292,7 @@ int BlisTreeNode::installSubProblem()
 	}
 #endif
 
+	delete pws;
     }
 
     return status;
@@ -980,7 +1303,7 @@ int BlisTreeNode::installSubProblem()
 int
 BlisTreeNode::generateConstraints(BcpsConstraintPool *conPool)
 {
-    int i, numCGs;
+    int i, k, numCGs;
     int status = BLIS_LP_OPTIMAL;
     int preNumRowCons = 0;
     int preNumColCons = 0;
@@ -1065,6 +1388,16 @@ BlisTreeNode::generateConstraints(BcpsConstraintPool *conPool)
 		}
 	    }
 
+	    //------------------------------------------------
+	    // Store generated constraints in the pool.
+	    //------------------------------------------------
+
+	    newCons = new_cuts.sizeRowCuts();
+	    for (k = 0; k < newCons; ++k) {
+		conPool->addConstraint(
+		    BlisOsiCutToConstraint(&(new_cuts.rowCut(k))));
+	    }
+
 	    //------------------------------------------------
 	    // Modify control.
 	    // NOTE: only modify if user choose automatic.
@@ -1125,14 +1458,32 @@ void BlisTreeNode::branchConstrainOrPrice(
 
   int objSense = model->BlisPar()->entry(BlisParams::objSense);
   if (numColsInf) {
-    branch = true;
+    if (numConPassesLeft_ > 0 && model->useCons() > -2) {
+      // try to cut off the fractional solution first
+      keepBounding = true;
+      generateConstraints = true;
+    }
+    else {
+      branch = true;
+    }
   }
   else if (sol) {
     sol->setDepth(depth_);
-    // Store in Alps pool
-    broker()->addKnowledge(AlpsKnowledgeTypeSolution,
-                           sol,
-                           objSense * sol->getQuality());
+    // Keep the lp solution as incumbent, the guided dive rounds toward it.
+    double value = objSense * sol->getQuality();
+    model->setBestSolution(BLIS_SOL_BOUNDING, value,
+                           model->solver()->getColSolution());
+    // Store in Alps pool, unless it was found before
+    if (model->solutionPool()->add(model->solver()->getNumCols(),
+                                   model->solver()->getColSolution(),
+                                   value)) {
+      broker()->addKnowledge(AlpsKnowledgeTypeSolution,
+                             sol,
+                             objSense * sol->getQuality());
+    }
+    else {
+      delete sol;
+    }
     // update solver with the new incumbent if better
     double incum_val = broker()->getIncumbentValue();
     model->solver()->setDblParam(OsiDualObjectiveLimit,
@@ -1146,7 +1497,90 @@ void BlisTreeNode::branchConstrainOrPrice(
   }
 }
 
+/** Call the heuristics due at this node, the ones that found most
+    solutions per second first, until the node time budget is used. A
+    heuristic whose average call would not fit in what is left is
+    skipped. */
 void BlisTreeNode::callHeuristics() {
+  BlisModel * model = dynamic_cast<BlisModel*>(broker_->getModel());
+  OsiSolverInterface * solver = model->solver();
+  BlisHeurWorker * worker = model->heurWorker();
+  if (worker) {
+    // Report what the heuristic thread found since the last node, then
+    // hand it this node's lp. Heuristics that need the lp solver still
+    // run here.
+    double heurValue;
+    double * heurSolution = new double [solver->getNumCols()];
+    while (worker->collect(heurValue, heurSolution)) {
+      if (heurValue < broker()->getIncumbentValue()) {
+        storeHeurSolution(model, BLIS_SOL_ROUNDING, heurValue, heurSolution);
+      }
+    }
+    delete [] heurSolution;
+    if (getStatus() != AlpsNodeStatusFathomed &&
+        solver->isProvenOptimal()) {
+      worker->post(solver->getColLower(), solver->getColUpper(),
+                   solver->getColSolution(),
+                   solver->getObjSense() * solver->getObjValue(),
+                   broker()->getIncumbentValue());
+    }
+  }
+  if (model->numHeuristics() == 0 ||
+      getStatus() == AlpsNodeStatusFathomed ||
+      !solver->isProvenOptimal()) {
+    return;
+  }
+  double budget = model->BlisPar()->entry(BlisParams::heurNodeTime);
+  budget -= heurTime_;
+  if (budget <= 0.0) {
+    return;
+  }
+  std::vector<std::pair<double, int> > order;
+  for (int k = 0; k < model->numHeuristics(); ++k) {
+    BlisHeuristic * heur = model->heuristics(k);
+    if (worker && heur->hasSnapshotSearch()) {
+      continue;
+    }
+    if (heur->scheduled(model->getNumNodes(), depth_)) {
+      order.push_back(std::make_pair(-heur->efficiency(), k));
+    }
+  }
+  if (order.empty()) {
+    return;
+  }
+  std::sort(order.begin(), order.end());
+
+  double * heurSolution = new double [solver->getNumCols()];
+  double start = CoinCpuTime();
+  for (size_t i = 0; i < order.size(); ++i) {
+    BlisHeuristic * heur = model->heuristics(order[i].second);
+    if (CoinCpuTime() - start + heur->averageTime() > budget) {
+      continue;
+    }
+    double heurValue = broker()->getIncumbentValue();
+    if (heur->searchSolution(heurValue, heurSolution)) {
+      storeHeurSolution(model, heur->solType(), heurValue, heurSolution);
+    }
+  }
+  heurTime_ += CoinCpuTime() - start;
+  delete [] heurSolution;
+}
+
+//#############################################################################
+
+void BlisTreeNode::storeHeurSolution(BlisModel * model, BLIS_SOL_TYPE how,
+                                     double value, const double * x) {
+  int objSense = model->BlisPar()->entry(BlisParams::objSense);
+  model->setBestSolution(how, value, x);
+  if (!model->solutionPool()->add(model->solver()->getNumCols(), x, value)) {
+    return;
+  }
+  BlisSolution * sol = model->createSolution(x, objSense * value);
+  sol->setDepth(depth_);
+  broker()->addKnowledge(AlpsKnowledgeTypeSolution, sol, value);
+  // update solver with the new incumbent
+  double incum_val = broker()->getIncumbentValue();
+  model->solver()->setDblParam(OsiDualObjectiveLimit, objSense*incum_val);
 }
 
 //#############################################################################
@@ -1154,6 +1588,205 @@ void BlisTreeNode::callHeuristics() {
 void
 BlisTreeNode::applyConstraints(BcpsConstraintPool const * conPool)
 {
+    int k;
+    BlisModel *model = dynamic_cast<BlisModel*>(broker()->getModel());
+
+    int numOldCons = model->getNumOldConstraints();
+    int numNewCons = conPool->getNumConstraints();
+
+    // Do not exceed the max number of constraints allowed in the lp.
+    numNewCons = std::min(numNewCons, model->getMaxNumCons() - numOldCons);
+
+    if (numNewCons <= 0) {
+        // Nothing to add, stop generating constraints at this node.
+        numConPassesLeft_ = 0;
+        return;
+    }
+    --numConPassesLeft_;
+
+    //------------------------------------------------------
+    // Make sure model->oldConstraints() can hold the new ones. It
+    // stores the non-core constraints in the same order as the lp rows.
+    //------------------------------------------------------
+
+    if (numOldCons + numNewCons > model->getOldConstraintsSize()) {
+        int maxOld = 2 * (numOldCons + numNewCons);
+        BlisConstraint **tempCons = new BlisConstraint* [maxOld];
+        memcpy(tempCons,
+               model->oldConstraints(),
+               numOldCons * sizeof(BlisConstraint *));
+        model->delOldConstraints();
+        model->setOldConstraints(tempCons);
+        model->setOldConstraintsSize(maxOld);
+    }
+
+    //------------------------------------------------------
+    // Add to lp solver and record in the node description. The pool
+    // will be cleared, so the description keeps copies.
+    //------------------------------------------------------
+
+    BcpsObject ** newCons = new BcpsObject* [numNewCons];
+
+    for (k = 0; k < numNewCons; ++k) {
+        BlisConstraint *aCon = dynamic_cast<BlisConstraint *>
+            (conPool->getConstraint(k));
+        assert(aCon);
+        BlisConstraint *newCon = new BlisConstraint(*aCon);
+        newCons[k] = newCon;
+        (model->oldConstraints())[numOldCons + k] = newCon;
+    }
+
+    BlisAddConstraintsToSolver(model->solver(),
+                               numNewCons,
+                               model->oldConstraints() + numOldCons);
+    model->setNumOldConstraints(numOldCons + numNewCons);
+
+    // Take over the memory of constraints, not the array.
+    getDesc()->appendAddedConstraints(numNewCons, newCons);
+
+    delete [] newCons;
+}
+
+//#############################################################################
+
+int BlisTreeNode::
+removeSlackConstraints(BlisModel *model)
+{
+    int k;
+
+    int numOldCons = model->getNumOldConstraints();
+    int inactiveLimit = model->BlisPar()->entry(BlisParams::cutInactiveLimit);
+
+    if (numOldCons == 0) return 0;
+
+    int numCoreCons = model->getNumCoreConstraints();
+    assert(model->solver()->getNumRows() == numCoreCons + numOldCons);
+
+    const double *rowAct = model->solver()->getRowActivity();
+    const double *rowLB = model->solver()->getRowLower();
+    const double *rowUB = model->solver()->getRowUpper();
+    double epSlack = 1.0e-6;
+
+    BlisConstraint **oldCons = model->oldConstraints();
+    BlisConstraint *aCon = NULL;
+
+    //------------------------------------------------------
+    // Age constraints, survived ones are compacted in oldCons. The
+    // constraint objects are the ones in the descriptions, so the age
+    // carries over to the nodes that inherit them.
+    //------------------------------------------------------
+
+    int numKeep = 0;
+    int numDel = 0;
+    int *delCons = new int [numOldCons];
+
+    for (k = 0; k < numOldCons; ++k) {
+        int row = numCoreCons + k;
+        aCon = oldCons[k];
+        if (rowAct[row] > rowLB[row] + epSlack &&
+            rowAct[row] < rowUB[row] - epSlack) {
+            aCon->setNumInactive(aCon->getNumInactive() + 1);
+        }
+        else {
+            aCon->setNumInactive(0);
+        }
+        if (inactiveLimit > 0 && aCon->getNumInactive() >= inactiveLimit) {
+            delCons[numDel++] = k;
+        }
+        else {
+            oldCons[numKeep++] = aCon;
+        }
+    }
+
+    if (numDel == 0) {
+        delete [] delCons;
+        return 0;
+    }
+
+#ifdef BLIS_DEBUG
+    std::cout << "REMOVE SLACK: node " << index_ << " removes " << numDel
+              << " of " << numOldCons << " constraints." << std::endl;
+#endif
+
+    //------------------------------------------------------
+    // Map lp rows to positions in the description list. The list
+    // is the parent's active constraints followed by the ones added
+    // at this node; active rows are the list minus posRemove.
+    //------------------------------------------------------
+
+    BlisNodeDesc *desc = getDesc();
+    BcpsObjectListMod *cons = desc->cons();
+
+    int numAdd = cons->numAdd;
+    int numRemove = cons->numRemove;
+    int numList = numOldCons + numRemove;
+    int numParent = numList - numAdd;
+    assert(numParent >= 0);
+
+    // 1: removed before, 2: removed now.
+    int *tempMark = new int [numList];
+    CoinZeroN(tempMark, numList);
+    for (k = 0; k < numRemove; ++k) {
+        tempMark[cons->posRemove[k]] = 1;
+    }
+
+    int pos = 0;
+    int d = 0;
+    for (k = 0; k < numOldCons && d < numDel; ++k, ++pos) {
+        while (tempMark[pos]) ++pos;
+        if (k == delCons[d]) {
+            tempMark[pos] = 2;
+            // Convert to lp row index for deleteRows.
+            delCons[d++] = numCoreCons + k;
+        }
+    }
+
+    //------------------------------------------------------
+    // Constraints added at this node are dropped from the description,
+    // inherited ones are recorded as removed.
+    //------------------------------------------------------
+
+    int *newPos = new int [numList];
+    int numKeepAdd = 0;
+    for (k = 0; k < numAdd; ++k) {
+        pos = numParent + k;
+        if (tempMark[pos] == 2) {
+            delete cons->objects[k];
+        }
+        else {
+            newPos[pos] = numParent + numKeepAdd;
+            cons->objects[numKeepAdd++] = cons->objects[k];
+        }
+    }
+    cons->numAdd = numKeepAdd;
+
+    int numNewRemove = 0;
+    int *posRemove = new int [numRemove + numDel];
+    for (pos = 0; pos < numList; ++pos) {
+        if (pos < numParent) {
+            if (tempMark[pos]) {
+                posRemove[numNewRemove++] = pos;
+            }
+        }
+        else if (tempMark[pos] == 1) {
+            posRemove[numNewRemove++] = newPos[pos];
+        }
+    }
+    // Take over the memory of posRemove.
+    desc->delConstraints(numNewRemove, posRemove);
+
+    //------------------------------------------------------
+    // Remove from lp solver.
+    //------------------------------------------------------
+
+    model->solver()->deleteRows(numDel, delCons);
+    model->setNumOldConstraints(numKeep);
+
+    delete [] newPos;
+    delete [] tempMark;
+    delete [] delCons;
+
+    return numDel;
 }
 
 //#############################################################################
@@ -1164,15 +1797,6 @@ reducedCostFix(BlisModel *model)
     int i, var;
     int status = BLIS_OK;
 
-    int numFixedUp = 0;
-    int numFixedDown = 0;
-    int numTighten = 0;
-
-    double movement;
-    double newBound;
-    double boundDistance;
-    double dj;
-
     const double *lb = model->solver()->getColLower();
     const double *ub = model->solver()->getColUpper();
     const double *solution = model->solver()->getColSolution();
@@ -1181,8 +1805,6 @@ reducedCostFix(BlisModel *model)
     double cutup = broker_->getIncumbentValue() *
         model->solver()->getObjSense();
 
-    if (cutup >= ALPS_OBJ_MAX) return status;
-
     double lpObjValue = model->solver()->getObjValue() *
         model->solver()->getObjSense();
     double epInt = 1.0e-5;
@@ -1190,74 +1812,299 @@ reducedCostFix(BlisModel *model)
     int numIntegers = model->getNumIntVars();
     const int *intIndices = model->getIntVars();
 
-    for (i = 0; i < numIntegers; ++i) {
-	var = intIndices[i];
+    bool globalFix = model->BlisPar()->entry(BlisParams::globalRcFix);
 
-        dj = reducedCost[var];
+    //------------------------------------------------------
+    // Root reduced costs fix columns at every node once a
+    // better incumbent is known.
+    //------------------------------------------------------
 
-        if (fabs(dj) < epInt) continue;
+    if (globalFix && depth_ == 0) {
+        model->setRootReducedCosts(solution, reducedCost, lb, ub, lpObjValue);
+    }
 
-        boundDistance = ub[var] - lb[var];
-	if (boundDistance < epInt) continue;
+    if (cutup >= ALPS_OBJ_MAX) return status;
+
+    if (globalFix) {
+        model->updateGlobalBounds(cutup);
+    }
+
+    if (numIntegers == 0) return status;
+
+    //------------------------------------------------------
+    // Gather reduced costs and compute the allowed movement
+    // of every integer column in one pass.
+    //------------------------------------------------------
+
+    double gap = cutup - lpObjValue;
+    if (gap < 0.0) return status;
+
+    double *movement = new double [numIntegers];
+    for (i = 0; i < numIntegers; ++i) {
+        movement[i] = fabs(reducedCost[intIndices[i]]);
+    }
+    for (i = 0; i < numIntegers; ++i) {
+        movement[i] = floor(gap / CoinMax(movement[i], epInt));
+    }
+
+    //------------------------------------------------------
+    // Collect the columns at a bound that can not move to the
+    // other bound.
+    //------------------------------------------------------
 
-        movement = floor((cutup - lpObjValue) / fabs(dj));
+    int numFix = 0;
+    int *fixInd = new int [numIntegers];
+    double *fixBounds = new double [2 * numIntegers];
 
+    for (i = 0; i < numIntegers; ++i) {
+	var = intIndices[i];
+        double boundDistance = ub[var] - lb[var];
+        if (fabs(reducedCost[var]) < epInt || boundDistance < epInt ||
+            movement[i] >= boundDistance) {
+            continue;
+        }
         if (solution[var] > ub[var] - epInt) {
-            /* At upper bound */
-            if (movement < boundDistance) {
-                /* new lower bound. If movement is 0, then fix. */
-                newBound = ub[var] - movement;
-                newBound = std::min(newBound, ub[var]);
+            /* At upper bound, new lower bound. If movement is 0, fix. */
+            fixInd[numFix] = var;
+            fixBounds[2 * numFix] = ub[var] - movement[i];
+            fixBounds[2 * numFix + 1] = ub[var];
+            ++numFix;
+        }
+        else if (solution[var] < lb[var] + epInt) {
+            /* At lower bound, new upper bound. If movement is 0, fix. */
+            fixInd[numFix] = var;
+            fixBounds[2 * numFix] = lb[var];
+            fixBounds[2 * numFix + 1] = lb[var] + movement[i];
+            ++numFix;
+        }
+    }
 
 #ifdef BLIS_DEBUG_MORE
-                printf("RED-FIX: dj %g, lb %.10g, ub %.10g, newBound %.10g, movement %g\n", dj, lb[var], ub[var], newBound, movement);
+    if (numFix > 0) {
+        printf("reducedCostFix: numFix = %d\n", numFix);
+    }
 #endif
 
-                if (movement <= ALPS_ZERO) {
-                    ++numFixedUp;
-                }
-                else if (newBound < ub[var]){
-                    ++numTighten;
-                }
-                model->solver()->setColLower(var, newBound);
+    if (numFix > 0) {
+        //--------------------------------------------------
+        // One bulk update of the lp, then propagate the new
+        // bounds. Both are kept as soft bounds of this node.
+        //--------------------------------------------------
+
+        model->solver()->setColSetBounds(fixInd, fixInd + numFix, fixBounds);
+
+        BlisPropagator *propagator = model->propagator();
+        if (propagator) {
+            for (i = 0; i < numFix; ++i) {
+                propagator->tightenLower(fixInd[i], fixBounds[2 * i]);
+                propagator->tightenUpper(fixInd[i], fixBounds[2 * i + 1]);
+            }
+            int numPasses = model->BlisPar()->entry(BlisParams::propagatePass);
+            if (propagator->propagate(numPasses) < 0) {
+                // No better solution in this subtree.
+                propagator->clearChanges();
+                status = BLIS_LP_PRIMAL_INF;
+            }
+            else {
+                applyPropagatedBounds(model);
             }
         }
-        else if (solution[var] < lb[var] + epInt) {
-            /* At lower bound */
-            if (movement < boundDistance) {
-                newBound = lb[var] + movement;
-                newBound = std::max(newBound, lb[var]);
+        else {
+            double *fixLower = new double [numFix];
+            double *fixUpper = new double [numFix];
+            for (i = 0; i < numFix; ++i) {
+                fixLower[i] = fixBounds[2 * i];
+                fixUpper[i] = fixBounds[2 * i + 1];
+            }
+            recordSoftBounds(numFix, fixInd, fixLower,
+                             numFix, fixInd, fixUpper);
+            delete [] fixLower;
+            delete [] fixUpper;
+        }
+    }
 
-#ifdef BLIS_DEBUG_MORE
-                printf("RED-FIX: dj %g, lb %g, ub %g, newBound %g, movement %g\n", dj, lb[var], ub[var], newBound, movement);
-#endif
+    delete [] movement;
+    delete [] fixInd;
+    delete [] fixBounds;
 
-                if (movement <= ALPS_ZERO) {
-                    ++numFixedDown;
-                }
-                else if(newBound > lb[var] ){
-                    ++numTighten;
-                }
-                /* new upper bound. If movement is 0, then fix. */
-                model->solver()->setColUpper(var, newBound);
+    return status;
+}
+
+
+//#############################################################################
+
+void BlisTreeNode::
+recordSoftBounds(int numLower, const int *lowerInd, const double *lowerVal,
+                 int numUpper, const int *upperInd, const double *upperVal)
+{
+    int k;
+
+    //------------------------------------------------------
+    // Bounds found while diving only hold below the dive.
+    //------------------------------------------------------
+
+    std::map<int, double>::iterator pos;
+    if (numDives_ > 0) {
+        for (k = 0; k < numLower; ++k) {
+            pos = diveSoftLower_.find(lowerInd[k]);
+            if (pos == diveSoftLower_.end()) {
+                diveSoftLower_[lowerInd[k]] = lowerVal[k];
+            }
+            else pos->second = CoinMax(pos->second, lowerVal[k]);
+        }
+        for (k = 0; k < numUpper; ++k) {
+            pos = diveSoftUpper_.find(upperInd[k]);
+            if (pos == diveSoftUpper_.end()) {
+                diveSoftUpper_[upperInd[k]] = upperVal[k];
             }
+            else pos->second = CoinMin(pos->second, upperVal[k]);
         }
+        return;
     }
 
-    //int change = numFixedUp + numFixedDown + numTighten;
-    //model->reducedCostFixed_ += change;
-#ifdef BLIS_DEBUG_MORE
-    if (numFixedUp > 0 || numFixedDown > 0 || numTighten > 0) {
-        printf("reducedCostFix: numFixedUp = %d, numFixedDown = %d, numTighten %d\n", numFixedUp, numFixedDown, numTighten);
+    //------------------------------------------------------
+    // Merge with the soft bounds already recorded at this node.
+    //------------------------------------------------------
+
+    BcpsObjectListMod *vars = getDesc()->vars();
+    std::map<int, double> softLower;
+    std::map<int, double> softUpper;
+
+    for (k = 0; k < vars->lbSoft.numModify; ++k) {
+        softLower[vars->lbSoft.posModify[k]] = vars->lbSoft.entries[k];
     }
+    for (k = 0; k < vars->ubSoft.numModify; ++k) {
+        softUpper[vars->ubSoft.posModify[k]] = vars->ubSoft.entries[k];
+    }
+
+    for (k = 0; k < numLower; ++k) {
+        pos = softLower.find(lowerInd[k]);
+        if (pos == softLower.end()) softLower[lowerInd[k]] = lowerVal[k];
+        else pos->second = CoinMax(pos->second, lowerVal[k]);
+    }
+    for (k = 0; k < numUpper; ++k) {
+        pos = softUpper.find(upperInd[k]);
+        if (pos == softUpper.end()) softUpper[upperInd[k]] = upperVal[k];
+        else pos->second = CoinMin(pos->second, upperVal[k]);
+    }
+
+    int numSoftLower = static_cast<int>(softLower.size());
+    int numSoftUpper = static_cast<int>(softUpper.size());
+    int *softLowerInd = new int [numSoftLower];
+    double *softLowerVal = new double [numSoftLower];
+    int *softUpperInd = new int [numSoftUpper];
+    double *softUpperVal = new double [numSoftUpper];
+
+    k = 0;
+    for (pos = softLower.begin(); pos != softLower.end(); ++pos, ++k) {
+        softLowerInd[k] = pos->first;
+        softLowerVal[k] = pos->second;
+    }
+    k = 0;
+    for (pos = softUpper.begin(); pos != softUpper.end(); ++pos, ++k) {
+        softUpperInd[k] = pos->first;
+        softUpperVal[k] = pos->second;
+    }
+
+    // Take over the memory.
+    getDesc()->assignVarSoftBound(numSoftLower, softLowerInd, softLowerVal,
+                                  numSoftUpper, softUpperInd, softUpperVal);
+}
+
+//#############################################################################
+
+void BlisTreeNode::
+tightenColBounds(BlisModel *model, int num, const int *ind,
+                 const double *lower, const double *upper)
+{
+    int k;
+    BlisPropagator *propagator = model->propagator();
+
+    for (k = 0; k < num; ++k) {
+        model->solver()->setColBounds(ind[k], lower[k], upper[k]);
+        if (propagator) {
+            propagator->tightenLower(ind[k], lower[k]);
+            propagator->tightenUpper(ind[k], upper[k]);
+        }
+    }
+    recordSoftBounds(num, ind, lower, num, ind, upper);
+}
+
+//#############################################################################
+
+void BlisTreeNode::
+applyPropagatedBounds(BlisModel *model)
+{
+    size_t k;
+    int j;
+
+    BlisPropagator *propagator = model->propagator();
+    const std::vector<int> &changedLower = propagator->getChangedLower();
+    const std::vector<int> &changedUpper = propagator->getChangedUpper();
+
+    if (changedLower.empty() && changedUpper.empty()) return;
+
+    const double *lower = propagator->getColLower();
+    const double *upper = propagator->getColUpper();
+
+    //------------------------------------------------------
+    // Set the lp bounds.
+    //------------------------------------------------------
+
+    int numLower = static_cast<int>(changedLower.size());
+    int numUpper = static_cast<int>(changedUpper.size());
+    double *lowerVal = new double [numLower];
+    double *upperVal = new double [numUpper];
+    int *boundInd = new int [numLower + numUpper];
+    double *boundVal = new double [2 * (numLower + numUpper)];
+
+    // A column in both lists is set twice with the same values.
+    int numBounds = 0;
+    for (k = 0; k < changedLower.size(); ++k) {
+        j = changedLower[k];
+        lowerVal[k] = lower[j];
+        boundInd[numBounds] = j;
+        boundVal[2 * numBounds] = lower[j];
+        boundVal[2 * numBounds + 1] = upper[j];
+        ++numBounds;
+    }
+    for (k = 0; k < changedUpper.size(); ++k) {
+        j = changedUpper[k];
+        upperVal[k] = upper[j];
+        boundInd[numBounds] = j;
+        boundVal[2 * numBounds] = lower[j];
+        boundVal[2 * numBounds + 1] = upper[j];
+        ++numBounds;
+    }
+
+    model->solver()->setColSetBounds(boundInd, boundInd + numBounds, boundVal);
+
+    delete [] boundInd;
+    delete [] boundVal;
+
+    recordSoftBounds(numLower, numLower ? &changedLower[0] : NULL, lowerVal,
+                     numUpper, numUpper ? &changedUpper[0] : NULL, upperVal);
+
+    delete [] lowerVal;
+    delete [] upperVal;
+
+#ifdef BLIS_DEBUG
+    std::cout << "PROPAGATE: node " << index_ << " tightened "
+              << changedLower.size() << " lower and "
+              << changedUpper.size() << " upper bounds" << std::endl;
 #endif
 
-    return status;
+    propagator->clearChanges();
 }
 
+//#############################################################################
 
 AlpsReturnStatus BlisTreeNode::encode(AlpsEncoded * encoded) const {
   AlpsReturnStatus status;
+  if (poolTracked_) {
+    BlisModel * model = dynamic_cast<BlisModel*>(broker_->getModel());
+    model->restorePoolNode(const_cast<BlisTreeNode *>(this));
+  }
   status = AlpsTreeNode::encode(encoded);
   assert(status==AlpsReturnStatusOk);
   status = BcpsTreeNode::encode(encoded);
@@ -1308,6 +2155,7 @@ BlisTreeNode::convertToExplicit()
 	explicit_ = 1;
 
 	BlisModel* model = dynamic_cast<BlisModel*>(broker_->getModel());
+	model->restorePoolNode(this);
 	BlisNodeDesc *desc = dynamic_cast<BlisNodeDesc *>(desc_);
 	BlisConstraint *aCon = NULL;
 
@@ -1389,6 +2237,15 @@ BlisTreeNode::convertToExplicit()
 	    // Full variable hard bounds.
 	    //--------------------------------------
 
+	    if (pathDesc->getSharedHardBounds()) {
+		BlisSharedBounds *sharedBounds =
+		    pathDesc->getSharedHardBounds();
+		memcpy(fVarHardLB, sharedBounds->getLower(),
+		       sharedBounds->getSize() * sizeof(double));
+		memcpy(fVarHardUB, sharedBounds->getUpper(),
+		       sharedBounds->getSize() * sizeof(double));
+	    }
+
 	    numModify = pathDesc->getVars()->lbHard.numModify;
 	    for (k = 0; k < numModify; ++k) {
 		index = pathDesc->getVars()->lbHard.posModify[k];
@@ -1527,6 +2384,8 @@ BlisTreeNode::convertToExplicit()
 				 numCols,
 				 fVarHardUBInd,
 				 fVarHardUB);
+	// Full set is stored, no need for the shared block.
+	desc->setSharedHardBounds(NULL);
 
 	//------------------------------------------
 	// Recode soft variable bound. Modified.
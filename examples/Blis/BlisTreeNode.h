@@ -26,6 +26,9 @@
 
 //#############################################################################
 
+#include <map>
+#include <vector>
+
 #include "AlpsNodeDesc.h"
 
 #include "BcpsObjectPool.h"
@@ -63,6 +66,43 @@ class BlisTreeNode : public BcpsTreeNode {
     /** Save an explicit node description. */
     //void saveExplicit();
 
+    /** Number of constraint generation rounds left at this node. */
+    int numConPassesLeft_;
+
+    /** If the description is counted against the node memory limit. */
+    bool poolTracked_;
+
+    /** Cpu time used by primal heuristics at this node. */
+    double heurTime_;
+
+    /** Number of children processed in place at this node, see
+        diveInPlace(). */
+    int numDives_;
+
+    /** Lp bound of this node when the dive started. */
+    double diveStartQuality_;
+
+    /** Branching of the last child processed in place and the lp bound
+        of its parent, for the pseudocost update. */
+    int diveDir_;
+    int diveInd_;
+    double diveVal_;
+    double diveParentQuality_;
+
+    /** Column bounds of the child processed in place, on top of the
+        bounds of this node. */
+    std::map<int, double> diveLower_;
+    std::map<int, double> diveUpper_;
+
+    /** Soft bounds found while diving. They only hold below the dive and
+        are given to the children it leaves behind, not to this node. */
+    std::map<int, double> diveSoftLower_;
+    std::map<int, double> diveSoftUpper_;
+
+    /** Children left behind by the dive, returned by branch(). */
+    std::vector< CoinTriple<AlpsNodeDesc*, AlpsNodeStatus, double> >
+        diveSiblings_;
+
  public:
 
     /** Default constructor. */
@@ -85,17 +125,42 @@ class BlisTreeNode : public BcpsTreeNode {
     }
 
     /** Destructor. */
-    virtual ~BlisTreeNode() {
-        //delete constraintPool_;
-        //delete variablePool_;
-    }
+    virtual ~BlisTreeNode();
 
     /** Initilize member data when constructing a node. */
     void init() {
         //constraintPool_ = new BcpsConstraintPool;
         //variablePool_ = new BcpsVariablePool;
+        numConPassesLeft_ = 0;
+        poolTracked_ = false;
+        heurTime_ = 0.0;
+        numDives_ = 0;
+        diveStartQuality_ = 0.0;
+        diveDir_ = 0;
+        diveInd_ = -1;
+        diveVal_ = 0.0;
+        diveParentQuality_ = 0.0;
     }
 
+    /** Number of children processed in place at this node. */
+    int getNumDives() const { return numDives_; }
+
+    /** Branching of the last child processed in place and the lp bound of
+        its parent. Return false if this node did not dive. */
+    bool getDiveBranch(int &dir, int &ind, double &value,
+                       double &parentQuality) const {
+        if (numDives_ == 0) return false;
+        dir = diveDir_;
+        ind = diveInd_;
+        value = diveVal_;
+        parentQuality = diveParentQuality_;
+        return true;
+    }
+
+    /** If the description is counted against the node memory limit. */
+    bool isPoolTracked() const { return poolTracked_; }
+    void setPoolTracked(bool tracked) { poolTracked_ = tracked; }
+
     /** Create a new node based on given desc. */
     AlpsTreeNode* createNewTreeNode(AlpsNodeDesc *&desc) const;
 
@@ -129,6 +194,61 @@ class BlisTreeNode : public BcpsTreeNode {
     /** Fix and tighten varaibles based optimality conditions. */
     int reducedCostFix(BlisModel *model);
 
+    /** Process the preferred child of the branching object in place: the
+        other child is kept for branch(), and only the bound of the
+        branching variable changes in the lp. Return false if the dive
+        depth or gap limit is reached, the node is then branched. */
+    bool diveInPlace(BlisModel *model);
+
+    /** Set the hard bounds of a child of this node, on top of the bounds
+        of this node, and the soft bounds found while diving. */
+    void setChildBounds(BlisNodeDesc *child,
+                        const std::map<int, double> &lower,
+                        const std::map<int, double> &upper) const;
+
+    /** Create the description of a child left behind by the dive. Its
+        parent bound is not the one of this node, so it has no branching
+        direction and does not update pseudocosts. */
+    BlisNodeDesc *createDiveChild(BlisModel *model,
+                                  const std::map<int, double> &lower,
+                                  const std::map<int, double> &upper) const;
+
+    /** Move the children left behind by the dive to res. */
+    void takeDiveSiblings(std::vector< CoinTriple<AlpsNodeDesc*,
+                          AlpsNodeStatus, double> > &res);
+
+    /** Record column bounds as soft bounds of this node, merged with the
+        soft bounds it already has. While diving they are kept for the
+        children instead. */
+    void recordSoftBounds(int numLower, const int *lowerInd,
+                          const double *lowerVal,
+                          int numUpper, const int *upperInd,
+                          const double *upperVal);
+
+    /** Tighten column bounds of this node, e.g. when strong branching
+        finds one child infeasible. The bounds are set in the lp solver
+        and the propagator, and recorded as soft bounds. */
+    void tightenColBounds(BlisModel *model, int num, const int *ind,
+                          const double *lower, const double *upper);
+
+    /** Set the column bounds tightened by the propagator in the lp solver
+        and record them as soft bounds of this node, so that the subtree
+        starts from them. */
+    void applyPropagatedBounds(BlisModel *model);
+
+    /** Report a heuristic solution of the given value (minimization form)
+        to the broker and tighten the lp cutoff. */
+    void storeHeurSolution(BlisModel *model, BLIS_SOL_TYPE how,
+                           double value, const double *x);
+
+    /** Age the non-core constraints in the lp according to their slackness
+        at the current lp solution. The count of consecutive slack rounds
+        is kept on the constraint objects and carries over to the nodes
+        that inherit them. Remove the ones that have been slack for too
+        many rounds from the lp solver and the node description. Return
+        the number removed. */
+    int removeSlackConstraints(BlisModel *model);
+
     ///@name Pure virtual functions inherited from Bcps.
     //@{
     virtual int generateConstraints(BcpsConstraintPool *conPool);
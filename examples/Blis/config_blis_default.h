@@ -0,0 +1,38 @@
+/*===========================================================================*
+ * This file is part of the Bcps Linear Solver (BLIS).                       *
+ *                                                                           *
+ * BLIS is distributed under the Eclipse Public License as part of the       *
+ * COIN-OR repository (http://www.coin-or.org).                              *
+ *                                                                           *
+ * Authors:                                                                  *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *                                                                           *
+ * Conceptual Design:                                                        *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *          Laszlo Ladanyi, IBM T.J. Watson Research Center                  *
+ *          Matthew Saltzman, Clemson University                             *
+ *                                                                           *
+ *                                                                           *
+ * Copyright (C) 2001-2017, Lehigh University, Yan Xu, and Ted Ralphs.       *
+ * All Rights Reserved.                                                      *
+ *===========================================================================*/
+
+
+/***************************************************************************/
+/*        HERE DEFINE THE SYSTEM FACILITIES USED BY THE BLIS EXAMPLE       */
+/*    These are only in effect in a setting that doesn't use configure     */
+/***************************************************************************/
+
+/* Nothing is assumed: without configure, Blis reads the instance cache
+   with stdio, does not share the model between processes, and runs the
+   heuristics at the nodes. Define the HAVE_ macros of config_blis.h.in
+   here to enable what the system provides. */
+
+#ifndef __CONFIG_BLIS_DEFAULT_H__
+#define __CONFIG_BLIS_DEFAULT_H__
+
+#endif
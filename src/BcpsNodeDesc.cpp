@@ -24,6 +24,9 @@
 
 //#############################################################################
 
+#include <exception>
+#include <iostream>
+
 #include "AlpsKnowledgeBroker.h"
 
 #include "BcpsTreeNode.h"
@@ -32,77 +35,11 @@
 //#############################################################################
 
 BcpsNodeDesc:: ~BcpsNodeDesc() {
-    int k;
-
-    //------------------------------------------------------
-    // Free variable related.
-    //------------------------------------------------------
-
-    delete [] vars_->posRemove;
-    vars_->posRemove = NULL;
-
-    for (k = 0; k < vars_->numAdd; ++k) {
-        delete vars_->objects[k];
-    }
-    delete [] vars_->objects;
-    vars_->objects = NULL;
-
-    delete [] vars_->lbHard.posModify;
-    vars_->lbHard.posModify = NULL;
-    delete [] vars_->lbHard.entries;
-    vars_->lbHard.entries = NULL;
-
-    delete [] vars_->ubHard.posModify;
-    vars_->ubHard.posModify = NULL;
-    delete [] vars_->ubHard.entries;
-    vars_->ubHard.entries = NULL;
-
-    delete [] vars_->lbSoft.posModify;
-    vars_->lbSoft.posModify = NULL;
-    delete [] vars_->lbSoft.entries;
-    vars_->lbSoft.entries = NULL;
-
-    delete [] vars_->ubSoft.posModify;
-    vars_->ubSoft.posModify = NULL;
-    delete [] vars_->ubSoft.entries;
-    vars_->ubSoft.entries = NULL;
-
+    clearObjectMods(vars_);
     delete vars_;
     vars_ = NULL;
 
-    //------------------------------------------------------
-    // Free constraint related.
-    //------------------------------------------------------
-
-    delete [] cons_->posRemove;
-    cons_->posRemove = NULL;
-
-    for (k = 0; k < cons_->numAdd; ++k) {
-        delete cons_->objects[k];
-    }
-    delete [] cons_->objects;
-    cons_->objects = NULL;
-
-    delete [] cons_->lbHard.posModify;
-    cons_->lbHard.posModify = NULL;
-    delete [] cons_->lbHard.entries;
-    cons_->lbHard.entries = NULL;
-
-    delete [] cons_->ubHard.posModify;
-    cons_->ubHard.posModify = NULL;
-    delete [] cons_->ubHard.entries;
-    cons_->ubHard.entries = NULL;
-
-    delete [] cons_->lbSoft.posModify;
-    cons_->lbSoft.posModify = NULL;
-    delete [] cons_->lbSoft.entries;
-    cons_->lbSoft.entries = NULL;
-
-    delete [] cons_->ubSoft.posModify;
-    cons_->ubSoft.posModify = NULL;
-    delete [] cons_->ubSoft.entries;
-    cons_->ubSoft.entries = NULL;
-
+    clearObjectMods(cons_);
     delete cons_;
     cons_ = NULL;
 }
@@ -174,6 +111,9 @@ void BcpsNodeDesc::initToNull() {
     cons_->ubSoft.numModify = 0;
     cons_->ubSoft.posModify = NULL;
     cons_->ubSoft.entries = NULL;
+
+    spillPos_ = -1;
+    spillSize_ = 0;
 }
 
 //#############################################################################
@@ -986,7 +926,8 @@ BcpsNodeDesc::decodeIntFieldMods(AlpsEncoded &encoded,
 
 AlpsReturnStatus
 BcpsNodeDesc::decodeObjectMods(AlpsEncoded &encoded,
-                               BcpsObjectListMod *objMod)
+                               BcpsObjectListMod *objMod,
+                               int type)
 {
     int k;
     AlpsReturnStatus status = AlpsReturnStatusOk;
@@ -1000,10 +941,8 @@ BcpsNodeDesc::decodeObjectMods(AlpsEncoded &encoded,
     if (objMod->numAdd > 0) {
         objMod->objects = new BcpsObject* [objMod->numAdd];
         for (k = 0; k < objMod->numAdd; ++k) {
-            objMod->objects[k]->decodeToSelf(encoded);
-
             // Unpack a object from an encoded.
-            // (objMod->objects)[k]->encode(encoded);
+            objMod->objects[k] = decodeObject(encoded, type);
         }
     }
 
@@ -1030,9 +969,154 @@ AlpsReturnStatus BcpsNodeDesc::decodeBcps(AlpsEncoded &encoded)
     AlpsReturnStatus status = AlpsReturnStatusOk;
 
     //std::cout << "---- BCPS decoded vars" << std::endl;
-    status = decodeObjectMods(encoded, vars_);
+    status = decodeObjectMods(encoded, vars_, BcpsKnowledgeTypeVariable);
     //std::cout << "---- BCPS decoded cons" << std::endl;
-    status = decodeObjectMods(encoded, cons_);
+    status = decodeObjectMods(encoded, cons_, BcpsKnowledgeTypeConstraint);
+
+    return status;
+}
+
+//#############################################################################
+
+void BcpsNodeDesc::clearObjectMods(BcpsObjectListMod *objMod)
+{
+    int k;
+
+    delete [] objMod->posRemove;
+    objMod->posRemove = NULL;
+    objMod->numRemove = 0;
+
+    for (k = 0; k < objMod->numAdd; ++k) {
+        delete objMod->objects[k];
+    }
+    delete [] objMod->objects;
+    objMod->objects = NULL;
+    objMod->numAdd = 0;
+
+    delete [] objMod->lbHard.posModify;
+    objMod->lbHard.posModify = NULL;
+    delete [] objMod->lbHard.entries;
+    objMod->lbHard.entries = NULL;
+    objMod->lbHard.numModify = 0;
+
+    delete [] objMod->ubHard.posModify;
+    objMod->ubHard.posModify = NULL;
+    delete [] objMod->ubHard.entries;
+    objMod->ubHard.entries = NULL;
+    objMod->ubHard.numModify = 0;
+
+    delete [] objMod->lbSoft.posModify;
+    objMod->lbSoft.posModify = NULL;
+    delete [] objMod->lbSoft.entries;
+    objMod->lbSoft.entries = NULL;
+    objMod->lbSoft.numModify = 0;
+
+    delete [] objMod->ubSoft.posModify;
+    objMod->ubSoft.posModify = NULL;
+    delete [] objMod->ubSoft.entries;
+    objMod->ubSoft.entries = NULL;
+    objMod->ubSoft.numModify = 0;
+}
+
+//#############################################################################
+
+size_t
+BcpsNodeDesc::objectModsMemory(const BcpsObjectListMod *objMod) const
+{
+    int k;
+    size_t bytes = sizeof(BcpsObjectListMod);
+
+    if (objMod->numRemove > 0) {
+        bytes += objMod->numRemove * sizeof(int);
+    }
+    bytes += objMod->numAdd * sizeof(BcpsObject *);
+    for (k = 0; k < objMod->numAdd; ++k) {
+        if (objMod->objects[k]) {
+            bytes += objMod->objects[k]->getMemoryUsage();
+        }
+    }
+
+    const size_t entry = sizeof(int) + sizeof(double);
+    bytes += objMod->lbHard.numModify * entry;
+    bytes += objMod->ubHard.numModify * entry;
+    bytes += objMod->lbSoft.numModify * entry;
+    bytes += objMod->ubSoft.numModify * entry;
+
+    return bytes;
+}
+
+//#############################################################################
+
+size_t BcpsNodeDesc::getMemoryUsage() const
+{
+    size_t bytes = sizeof(BcpsNodeDesc);
+    if (spillPos_ < 0) {
+        bytes += objectModsMemory(vars_);
+        bytes += objectModsMemory(cons_);
+    }
+    return bytes;
+}
+
+//#############################################################################
+
+/** Spilled modifications are appended to the file, space is not reused.
+    The caller decides when the file can be truncated. */
+AlpsReturnStatus BcpsNodeDesc::spill(FILE *file)
+{
+    if (spillPos_ >= 0) {
+        return AlpsReturnStatusOk;
+    }
+
+    AlpsEncoded encoded(AlpsKnowledgeTypeNode);
+    encodeBcps(&encoded);
+
+    if (fseek(file, 0, SEEK_END) != 0) {
+        return AlpsReturnStatusErr;
+    }
+    long pos = ftell(file);
+    size_t size = static_cast<size_t>(encoded.size());
+    if (pos < 0 ||
+        fwrite(encoded.representation(), 1, size, file) != size) {
+        return AlpsReturnStatusErr;
+    }
+
+    spillPos_ = pos;
+    spillSize_ = encoded.size();
+
+    // Keep the relative flags, they are part of the encoded data too.
+    clearObjectMods(vars_);
+    clearObjectMods(cons_);
+
+    return AlpsReturnStatusOk;
+}
+
+//#############################################################################
+
+AlpsReturnStatus BcpsNodeDesc::unspill(FILE *file)
+{
+    if (spillPos_ < 0) {
+        return AlpsReturnStatusOk;
+    }
+
+    char *buffer = new char [spillSize_];
+    size_t size = static_cast<size_t>(spillSize_);
+
+    if (fseek(file, spillPos_, SEEK_SET) != 0 ||
+        fread(buffer, 1, size, file) != size) {
+        delete [] buffer;
+        std::cerr << "BcpsNodeDesc::unspill: failed to read "
+                  << spillSize_ << " bytes at " << spillPos_ << std::endl;
+        throw std::exception();
+    }
+
+    // The encoded object takes over the buffer and sets it to NULL.
+    AlpsEncoded encoded(AlpsKnowledgeTypeNode, spillSize_, buffer);
+    delete [] buffer;
+
+    AlpsReturnStatus status = decodeBcps(encoded);
+
+    spillPos_ = -1;
+    spillSize_ = 0;
 
     return status;
 }
@@ -24,6 +24,8 @@
 #ifndef BcpsNodeDesc_h_
 #define BcpsNodeDesc_h_
 
+#include <cstdio>
+
 #include "BcpsConfig.h"
 #include "BcpsModel.h"
 
@@ -137,6 +139,13 @@ class BCPSLIB_EXPORT BcpsNodeDesc : public AlpsNodeDesc {
     /** Constraint objects. */
     BcpsObjectListMod *cons_;
 
+    /** Position of the spilled modifications in the spill file, -1 if
+        they are in memory. */
+    long spillPos_;
+
+    /** Number of bytes written to the spill file. */
+    int spillSize_;
+
  public:
 
     /** Default constructor. */
@@ -362,8 +371,29 @@ class BCPSLIB_EXPORT BcpsNodeDesc : public AlpsNodeDesc {
         vars_->posRemove = indices;
     }
 
+    /** Return the number of bytes owned by the variable and constraint
+        modifications. Added objects are counted by their base size. */
+    virtual size_t getMemoryUsage() const;
+
+    /** Return true if the modifications are in the spill file. */
+    bool isSpilled() const { return spillPos_ >= 0; }
+
+    /** Append the modifications to the end of file and free them. Return
+        AlpsReturnStatusErr and keep the description if writing failed. */
+    AlpsReturnStatus spill(FILE *file);
+
+    /** Read back the modifications spilled to file. */
+    AlpsReturnStatus unspill(FILE *file);
+
  protected:
 
+    /** Free the arrays of an object modification list and reset it to an
+        empty list. */
+    void clearObjectMods(BcpsObjectListMod *objMod);
+
+    /** Return the number of bytes owned by an object modification list. */
+    size_t objectModsMemory(const BcpsObjectListMod *objMod) const;
+
     /** Pack a double field into an encoded object. */
     AlpsReturnStatus encodeDblFieldMods(AlpsEncoded *encoded,
                                       BcpsFieldListMod<double> * field) const;
@@ -384,9 +414,17 @@ class BCPSLIB_EXPORT BcpsNodeDesc : public AlpsNodeDesc {
     AlpsReturnStatus decodeIntFieldMods(AlpsEncoded &encoded,
                                       BcpsFieldListMod<int> *field);
 
-    /** Unpack object modifications to an encoded object. */
+    /** Unpack object modifications to an encoded object. Added objects
+        are created by decodeObject with the given knowledge type. */
     AlpsReturnStatus decodeObjectMods(AlpsEncoded &encoded,
-                                    BcpsObjectListMod *objMod);
+                                    BcpsObjectListMod *objMod,
+                                    int type);
+
+    /** Create an added object of the given knowledge type,
+        BcpsKnowledgeTypeVariable or BcpsKnowledgeTypeConstraint, from an
+        encoded object. Only the application knows the object classes. */
+    virtual BcpsObject * decodeObject(AlpsEncoded &encoded,
+                                      int type) const = 0;
 
  public:
 
@@ -286,6 +286,10 @@ class BCPSLIB_EXPORT BcpsObject : public AlpsKnowledge {
     /** Return "down" estimate. Default: 1.0e-5. */
     virtual double downEstimate() const { return 1.0e-5; }
 
+    /** Return the memory used by the object in bytes. Objects that own
+        more data, e.g. constraint coefficients, should count it too. */
+    virtual size_t getMemoryUsage() const { return sizeof(BcpsObject); }
+
     virtual void printDesc() {}
 
  protected:
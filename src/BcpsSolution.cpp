@@ -23,14 +23,109 @@
 
 //#############################################################################
 
+#include <algorithm>
+#include <cmath>
+
 #include "BcpsSolution.h"
 
 //#############################################################################
 
+void
+BcpsSolution::setEntries(const double *values, double zeroTol)
+{
+    delete [] indices_;
+    indices_ = NULL;
+    delete [] values_;
+    values_ = NULL;
+
+    int num = 0;
+    for (int j = 0; j < size_; ++j) {
+        if (fabs(values[j]) > zeroTol) {
+            ++num;
+        }
+    }
+
+    if (num * (sizeof(int) + sizeof(double)) >= size_ * sizeof(double)) {
+        // Dense is smaller.
+        values_ = new double [size_];
+        memcpy(values_, values, sizeof(double) * size_);
+        numElements_ = size_;
+        return;
+    }
+
+    indices_ = new int [num > 0 ? num : 1];
+    values_ = new double [num > 0 ? num : 1];
+    numElements_ = 0;
+    for (int j = 0; j < size_; ++j) {
+        if (fabs(values[j]) > zeroTol) {
+            indices_[numElements_] = j;
+            values_[numElements_++] = values[j];
+        }
+    }
+}
+
+//#############################################################################
+
+int
+BcpsSolution::selectEntries(double etol, bool fractional,
+                            int *indices, double *values) const
+{
+    int num = 0;
+    for (int k = 0; k < numElements_; ++k) {
+        double value = values_[k];
+        double dist = fractional ? fabs(value - floor(value + 0.5)) :
+            fabs(value);
+        if (dist > etol) {
+            indices[num] = indices_ ? indices_[k] : k;
+            values[num++] = value;
+        }
+    }
+    return num;
+}
+
+//#############################################################################
+
+double
+BcpsSolution::getValue(int j) const
+{
+    if (!indices_) {
+        return values_[j];
+    }
+    const int *pos = std::lower_bound(indices_, indices_ + numElements_, j);
+    if (pos != indices_ + numElements_ && *pos == j) {
+        return values_[pos - indices_];
+    }
+    return 0.0;
+}
+
+//#############################################################################
+
+void
+BcpsSolution::getDenseValues(double *x) const
+{
+    if (!indices_) {
+        memcpy(x, values_, sizeof(double) * size_);
+        return;
+    }
+    std::fill(x, x + size_, 0.0);
+    for (int k = 0; k < numElements_; ++k) {
+        x[indices_[k]] = values_[k];
+    }
+}
+
+//#############################################################################
+
 BcpsSolution *
 BcpsSolution::selectNonzeros(const double etol) const
 {
-    BcpsSolution *sol = NULL;
+    int *indices = new int [numElements_ > 0 ? numElements_ : 1];
+    double *values = new double [numElements_ > 0 ? numElements_ : 1];
+    int num = selectEntries(etol, false, indices, values);
+
+    BcpsSolution *sol = new BcpsSolution(size_, num, indices, values,
+                                         quality_);
+    delete [] indices;
+    delete [] values;
 
     return sol;
 }
@@ -40,16 +135,30 @@ BcpsSolution::selectNonzeros(const double etol) const
 BcpsSolution*
 BcpsSolution::selectFractional(const double etol) const
 {
-    BcpsSolution *sol = NULL;
+    int *indices = new int [numElements_ > 0 ? numElements_ : 1];
+    double *values = new double [numElements_ > 0 ? numElements_ : 1];
+    int num = selectEntries(etol, true, indices, values);
+
+    BcpsSolution *sol = new BcpsSolution(size_, num, indices, values,
+                                         quality_);
+    delete [] indices;
+    delete [] values;
 
     return sol;
 }
 
+//#############################################################################
+
 /// Pack AlpsPar_ into a given encode object.
 AlpsReturnStatus BcpsSolution::encode(AlpsEncoded * encoded) const {
   AlpsReturnStatus status = AlpsReturnStatusOk;
+  int sparse = indices_ ? 1 : 0;
   encoded->writeRep(size_);
-  encoded->writeRep(values_, size_);
+  encoded->writeRep(sparse);
+  if (sparse) {
+    encoded->writeRep(indices_, numElements_);
+  }
+  encoded->writeRep(values_, numElements_);
   encoded->writeRep(quality_);
   return status;
 }
@@ -57,8 +166,21 @@ AlpsReturnStatus BcpsSolution::encode(AlpsEncoded * encoded) const {
 /// Decode the given AlpsEncoded object into this.
 AlpsReturnStatus BcpsSolution::decodeToSelf(AlpsEncoded & encoded) {
   AlpsReturnStatus status = AlpsReturnStatusOk;
+  int sparse = 0;
+  delete [] indices_;
+  indices_ = NULL;
+  delete [] values_;
+  values_ = NULL;
   encoded.readRep(size_);
-  encoded.readRep(values_, size_);
+  encoded.readRep(sparse);
+  if (sparse) {
+    encoded.readRep(indices_, numElements_);
+    if (!indices_) {
+      // No stored entries, keep the solution sparse.
+      indices_ = new int [1];
+    }
+  }
+  encoded.readRep(values_, numElements_);
   encoded.readRep(quality_);
   return status;
 }
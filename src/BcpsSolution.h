@@ -42,9 +42,16 @@ class BCPSLIB_EXPORT BcpsSolution : public AlpsSolution {
 
  protected:
 
-    /** Size of values_. */
+    /** Length of the solution vector. */
     int size_;
 
+    /** Number of stored values, size_ unless sparse. */
+    int numElements_;
+
+    /** Positions of the stored values in increasing order, NULL if the
+        solution is dense. */
+    int *indices_;
+
     /** List of objects associated with values. Can be NULL. */
     BcpsObject_p *objects_;
 
@@ -54,18 +61,32 @@ class BCPSLIB_EXPORT BcpsSolution : public AlpsSolution {
     /** Quality/Objective value associated with this solution. */
     double quality_;
 
+    /** Store the entries of values (dense, of length size_) that are
+        larger than zeroTol in absolute value. The sparse form is used if
+        it takes less memory than the dense one. */
+    void setEntries(const double *values, double zeroTol);
+
+    /** Copy the stored entries that are nonzero (fractional is false) or
+        fractional (fractional is true) up to etol into indices and values,
+        which must have room for numElements_ entries. Return the number of
+        entries copied. */
+    int selectEntries(double etol, bool fractional,
+                      int *indices, double *values) const;
+
  public:
 
     /** Default constructor. */
     BcpsSolution()
         :
-        size_(0), objects_(NULL), values_(NULL), quality_(ALPS_OBJ_MAX)
+        size_(0), numElements_(0), indices_(NULL), objects_(NULL),
+        values_(NULL), quality_(ALPS_OBJ_MAX)
         {}
 
     /** Useful constructor. */
     BcpsSolution(int size, const double *values, double q)
         :
-        size_(size), objects_(NULL), values_(NULL), quality_(q) {
+        size_(size), numElements_(size), indices_(NULL), objects_(NULL),
+        values_(NULL), quality_(q) {
 
         if (size > 0) {
             values_ = new double [size];
@@ -77,11 +98,35 @@ class BCPSLIB_EXPORT BcpsSolution : public AlpsSolution {
         }
     }
 
+    /** Useful constructor. Entries of values not larger than zeroTol in
+        absolute value are dropped, and the solution is stored sparse if
+        that is smaller. */
+    BcpsSolution(int size, const double *values, double q, double zeroTol)
+        :
+        size_(size), numElements_(0), indices_(NULL), objects_(NULL),
+        values_(NULL), quality_(q) {
+        setEntries(values, zeroTol);
+    }
+
+    /** Sparse constructor, copies num values at the given increasing
+        positions of a solution vector of length size. */
+    BcpsSolution(int size, int num, const int *indices, const double *values,
+                 double q)
+        :
+        size_(size), numElements_(num), indices_(NULL), objects_(NULL),
+        values_(NULL), quality_(q) {
+        indices_ = new int [num > 0 ? num : 1];
+        values_ = new double [num > 0 ? num : 1];
+        memcpy(indices_, indices, sizeof(int) * num);
+        memcpy(values_, values, sizeof(double) * num);
+    }
+
     /** Construct an object using the given arrays. Note that the new objects
         takes over the pointers and NULLs them out in the calling method. */
     BcpsSolution(int size, BcpsObject_p*& objects, double*& values, double q)
         :
-        size_(size), objects_(objects), values_(values), quality_(q) {
+        size_(size), numElements_(size), indices_(NULL), objects_(objects),
+        values_(values), quality_(q) {
         objects = NULL;
         values = NULL;
     }
@@ -89,11 +134,12 @@ class BCPSLIB_EXPORT BcpsSolution : public AlpsSolution {
     /** Distructor. */
     virtual ~BcpsSolution() {
         if (objects_) {
-            for (int i = 0; i < size_; ++i) {
+            for (int i = 0; i < numElements_; ++i) {
                 delete objects_[i];
             }
             delete[] objects_;
         }
+        delete[] indices_;
         delete[] values_;
     }
 
@@ -101,8 +147,19 @@ class BCPSLIB_EXPORT BcpsSolution : public AlpsSolution {
     /**@{ */
     inline int getSize() const { return size_; }
     inline const BcpsObject_p* getObjects() const { return objects_; }
-    inline const double* getValues() const { return values_; }
     inline double getQuality() const { return quality_; }
+    /** Return true if only the entries at getIndices() are stored. */
+    inline bool isSparse() const { return indices_ != NULL; }
+    /** Number of stored values, getSize() if dense. */
+    inline int getNumElements() const { return numElements_; }
+    /** Positions of the stored values, NULL if dense. */
+    inline const int* getIndices() const { return indices_; }
+    /** Stored values, getNumElements() of them. */
+    inline const double* getValues() const { return values_; }
+    /** Return the value at position j. */
+    double getValue(int j) const;
+    /** Write the full solution vector, getSize() entries, into x. */
+    void getDenseValues(double *x) const;
     /**@} */
 
    /** Set/assign the appropriate data member. */
@@ -112,17 +169,21 @@ class BCPSLIB_EXPORT BcpsSolution : public AlpsSolution {
         objects_ = obj;
         obj = NULL;
     }
+    /** Set a dense solution vector of length s. */
     inline void setValues(const double *vs, int s) {
-        if (!values_) delete [] values_;
+        delete [] indices_;
+        indices_ = NULL;
+        delete [] values_;
         values_ = new double [s];
         size_ = s;
+        numElements_ = s;
         memcpy(values_, vs, s * sizeof(double));
     }
     inline void setQuality(double q) { quality_ = q; }
     /**@} */
 
     /** Select the fractional/nonzero elements from the solution array and
-        return a new object in compacted form. */
+        return a new object in compacted form. Objects are not copied. */
     /**@{ */
     virtual BcpsSolution* selectNonzeros(const double etol = 1e-5) const;
     virtual BcpsSolution* selectFractional(const double etol = 1e-5) const;
@@ -130,9 +191,10 @@ class BCPSLIB_EXPORT BcpsSolution : public AlpsSolution {
 
     /** Print out the solution.*/
     virtual void print(std::ostream& os) const {
-        for (int j = 0; j < size_; ++j) {
-            if (values_[j] > 1.0e-15 || values_[j] < -1.0e-15) {
-                os << "x[" << j << "] = " << values_[j] << std::endl;
+        for (int k = 0; k < numElements_; ++k) {
+            if (values_[k] > 1.0e-15 || values_[k] < -1.0e-15) {
+                os << "x[" << (indices_ ? indices_[k] : k) << "] = "
+                   << values_[k] << std::endl;
             }
         }
     }
@@ -141,7 +203,7 @@ class BCPSLIB_EXPORT BcpsSolution : public AlpsSolution {
   //@{
   /// Get encode function defined in #AlpsKnowledge.
   using AlpsKnowledge::encode;
-  /// Pack into a given encode object.
+  /// Pack into a given encode object. Only the stored entries are packed.
   virtual AlpsReturnStatus encode(AlpsEncoded * encoded) const;
   /// Decode the given AlpsEncoded object into this.
   virtual AlpsReturnStatus decodeToSelf(AlpsEncoded & encoded);
@@ -0,0 +1,189 @@
+/*===========================================================================*
+ * This file is part of the Bcps Linear Solver (BLIS).                       *
+ *                                                                           *
+ * BLIS is distributed under the Eclipse Public License as part of the       *
+ * COIN-OR repository (http://www.coin-or.org).                              *
+ *                                                                           *
+ * Authors:                                                                  *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *                                                                           *
+ * Conceptual Design:                                                        *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *          Laszlo Ladanyi, IBM T.J. Watson Research Center                  *
+ *          Matthew Saltzman, Clemson University                             *
+ *                                                                           *
+ *                                                                           *
+ * Copyright (C) 2001-2017, Lehigh University, Yan Xu, and Ted Ralphs.       *
+ * All Rights Reserved.                                                      *
+ *===========================================================================*/
+
+
+// Check that warm start bases come back unchanged from an encoded object,
+// both when the status arrays are run length encoded, with runs at the
+// boundaries of the length bytes, and when they are sent as they are.
+// Return the number of failed checks.
+
+#include <iostream>
+
+#include "CoinWarmStartBasis.hpp"
+
+#include "Alps.h"
+#include "AlpsEncoded.h"
+
+#include "BlisHelp.h"
+
+//#############################################################################
+
+/** Report a failed check, return 1 if it failed and 0 otherwise. */
+static int
+check(bool ok, const char *what)
+{
+    if (!ok) {
+        std::cout << "  FAILED: " << what << std::endl;
+    }
+    return ok ? 0 : 1;
+}
+
+//#############################################################################
+
+/** Return true if the two bases have the same size and statuses. */
+static bool
+sameBasis(const CoinWarmStartBasis &a, const CoinWarmStartBasis &b)
+{
+    int i;
+    if (a.getNumStructural() != b.getNumStructural() ||
+        a.getNumArtificial() != b.getNumArtificial()) {
+        return false;
+    }
+    for (i = 0; i < a.getNumStructural(); ++i) {
+        if (a.getStructStatus(i) != b.getStructStatus(i)) {
+            return false;
+        }
+    }
+    for (i = 0; i < a.getNumArtificial(); ++i) {
+        if (a.getArtifStatus(i) != b.getArtifStatus(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//#############################################################################
+
+/** Bytes of a status array sent as it is. */
+static int
+rawSize(int n)
+{
+    return 4 * ((n + 15) >> 4);
+}
+
+//#############################################################################
+
+/** Encode ws, decode it and compare. If maxSize is positive, the encoded
+    size must not be larger. Return the number of failed checks. */
+static int
+roundTrip(const CoinWarmStartBasis &ws, int maxSize, const char *what)
+{
+    int numFailed = 0;
+
+    AlpsEncoded encoded(AlpsKnowledgeTypeNode);
+    BlisEncodeWarmStart(&encoded, &ws);
+
+    int size = encoded.size();
+
+    AlpsReturnStatus status = AlpsReturnStatusErr;
+    CoinWarmStartBasis *decoded = BlisDecodeWarmStart(encoded, &status);
+
+    std::cout << "  " << what << ": " << size << " bytes" << std::endl;
+    numFailed += check(status == AlpsReturnStatusOk, what);
+    numFailed += check(decoded != NULL && sameBasis(*decoded, ws), what);
+    if (maxSize > 0) {
+        numFailed += check(size <= maxSize, what);
+    }
+
+    delete decoded;
+    return numFailed;
+}
+
+//#############################################################################
+
+int main()
+{
+    int i, k;
+    int numFailed = 0;
+
+    std::cout << "Encoding warm start bases" << std::endl;
+
+    // Two sizes, the length of each status array and the method and
+    // length of its packed bytes.
+    const int header = 2 * 4 + 2 * (4 + 4);
+
+    //------------------------------------------------------
+    // Long runs. Run lengths 1, 32 and 33 sit at the edges of
+    // the first length byte, 4128 needs three bytes.
+    //------------------------------------------------------
+
+    const int numRuns = 5;
+    const int runLength[numRuns] = { 4500, 1, 32, 33, 4128 };
+    const CoinWarmStartBasis::Status runStatus[numRuns] = {
+        CoinWarmStartBasis::atLowerBound,
+        CoinWarmStartBasis::basic,
+        CoinWarmStartBasis::atUpperBound,
+        CoinWarmStartBasis::isFree,
+        CoinWarmStartBasis::basic
+    };
+    int numCols = 0;
+    for (k = 0; k < numRuns; ++k) {
+        numCols += runLength[k];
+    }
+    const int numRows = 300;
+
+    CoinWarmStartBasis runs;
+    runs.setSize(numCols, numRows);
+    int col = 0;
+    for (k = 0; k < numRuns; ++k) {
+        for (i = 0; i < runLength[k]; ++i) {
+            runs.setStructStatus(col++, runStatus[k]);
+        }
+    }
+    for (i = 0; i < numRows; ++i) {
+        runs.setArtifStatus(i, (i == 7) ? CoinWarmStartBasis::atLowerBound :
+                            CoinWarmStartBasis::basic);
+    }
+
+    // Each run takes at most three bytes.
+    numFailed += roundTrip(runs, header + 3 * numRuns + 3 * 3,
+                           "run length encoded basis");
+
+    //------------------------------------------------------
+    // No runs, sent as it is.
+    //------------------------------------------------------
+
+    const int numMixed = 70;
+    CoinWarmStartBasis mixed;
+    mixed.setSize(numMixed, numMixed);
+    for (i = 0; i < numMixed; ++i) {
+        mixed.setStructStatus(i, (i % 2) ? CoinWarmStartBasis::basic :
+                              CoinWarmStartBasis::atLowerBound);
+        mixed.setArtifStatus(i, (i % 3) ? CoinWarmStartBasis::atUpperBound :
+                             CoinWarmStartBasis::basic);
+    }
+    numFailed += roundTrip(mixed, header + 2 * rawSize(numMixed),
+                           "basis without runs");
+
+    //------------------------------------------------------
+    // Empty basis.
+    //------------------------------------------------------
+
+    CoinWarmStartBasis empty;
+    numFailed += roundTrip(empty, header, "empty basis");
+
+    std::cout << (numFailed == 0 ? "  ok" : "  FAILED") << std::endl;
+    return numFailed;
+}
+
+//#############################################################################
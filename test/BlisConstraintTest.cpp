@@ -0,0 +1,117 @@
+/*===========================================================================*
+ * This file is part of the Bcps Linear Solver (BLIS).                       *
+ *                                                                           *
+ * BLIS is distributed under the Eclipse Public License as part of the       *
+ * COIN-OR repository (http://www.coin-or.org).                              *
+ *                                                                           *
+ * Authors:                                                                  *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *                                                                           *
+ * Conceptual Design:                                                        *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *          Laszlo Ladanyi, IBM T.J. Watson Research Center                  *
+ *          Matthew Saltzman, Clemson University                             *
+ *                                                                           *
+ *                                                                           *
+ * Copyright (C) 2001-2017, Lehigh University, Yan Xu, and Ted Ralphs.       *
+ * All Rights Reserved.                                                      *
+ *===========================================================================*/
+
+
+// Check that a BlisConstraint comes back from an encoded object with the
+// same bounds and coefficients, for delta coded indices that go down, jump
+// far ahead and take several bytes. Return the number of failed checks.
+
+#include <iostream>
+
+#include "Alps.h"
+#include "AlpsEncoded.h"
+
+#include "BlisConstraint.h"
+
+//#############################################################################
+
+/** Report a failed check, return 1 if it failed and 0 otherwise. */
+static int
+check(bool ok, const char *what)
+{
+    if (!ok) {
+        std::cout << "  FAILED: " << what << std::endl;
+    }
+    return ok ? 0 : 1;
+}
+
+//#############################################################################
+
+/** Return true if the two constraints have the same bounds and entries. */
+static bool
+sameConstraint(const BlisConstraint &a, const BlisConstraint &b)
+{
+    if (a.getLbHard() != b.getLbHard() || a.getUbHard() != b.getUbHard() ||
+        a.getLbSoft() != b.getLbSoft() || a.getUbSoft() != b.getUbSoft() ||
+        a.getSize() != b.getSize()) {
+        return false;
+    }
+    for (int k = 0; k < a.getSize(); ++k) {
+        if (a.getIndices()[k] != b.getIndices()[k] ||
+            a.getValues()[k] != b.getValues()[k]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//#############################################################################
+
+int main()
+{
+    int numFailed = 0;
+
+    std::cout << "Encoding constraints" << std::endl;
+
+    const int size = 6;
+    const int indices[size] = { 3, 1, 130, 20000, 20001, 0 };
+    const double values[size] = { 1.0, -2.5, 0.125, 3.0e6, -1.0e-7, 7.0 };
+
+    BlisConstraint cut(-1.0, 4.0, -0.5, 3.5, size, indices, values);
+    BlisConstraint empty(0.0, 1.0, 0.0, 1.0);
+
+    numFailed += check(cut.getMemoryUsage() ==
+                       sizeof(BlisConstraint) +
+                       size * (sizeof(int) + sizeof(double)),
+                       "memory of the coefficients counted");
+
+    // Both go into one buffer, the second is read where the first ends.
+    AlpsEncoded encoded(BcpsKnowledgeTypeConstraint);
+    cut.encode(&encoded);
+    empty.encode(&encoded);
+
+    BlisConstraint *cutCopy =
+        dynamic_cast<BlisConstraint *>(cut.decode(encoded));
+    BlisConstraint *emptyCopy =
+        dynamic_cast<BlisConstraint *>(empty.decode(encoded));
+
+    numFailed += check(cutCopy != NULL && sameConstraint(*cutCopy, cut),
+                       "decoded constraint");
+    numFailed += check(emptyCopy != NULL && sameConstraint(*emptyCopy, empty),
+                       "decoded empty constraint");
+
+    // Decoding into an existing constraint replaces its entries.
+    AlpsEncoded again(BcpsKnowledgeTypeConstraint);
+    cut.encode(&again);
+    emptyCopy->decodeToSelf(again);
+    numFailed += check(sameConstraint(*emptyCopy, cut),
+                       "constraint decoded into an existing one");
+
+    delete cutCopy;
+    delete emptyCopy;
+
+    std::cout << (numFailed == 0 ? "  ok" : "  FAILED") << std::endl;
+    return numFailed;
+}
+
+//#############################################################################
@@ -0,0 +1,137 @@
+/*===========================================================================*
+ * This file is part of the Bcps Linear Solver (BLIS).                       *
+ *                                                                           *
+ * BLIS is distributed under the Eclipse Public License as part of the       *
+ * COIN-OR repository (http://www.coin-or.org).                              *
+ *                                                                           *
+ * Authors:                                                                  *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *                                                                           *
+ * Conceptual Design:                                                        *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *          Laszlo Ladanyi, IBM T.J. Watson Research Center                  *
+ *          Matthew Saltzman, Clemson University                             *
+ *                                                                           *
+ *                                                                           *
+ * Copyright (C) 2001-2017, Lehigh University, Yan Xu, and Ted Ralphs.       *
+ * All Rights Reserved.                                                      *
+ *===========================================================================*/
+
+// Read each MPS file given on the command line with BlisMpsReader and with
+// CoinMpsIO and check that both give the same problem. Return the number
+// of files that differ.
+
+#include <iostream>
+
+#include "CoinMpsIO.hpp"
+#include "CoinPackedMatrix.hpp"
+
+#include "BlisMpsReader.h"
+
+//#############################################################################
+
+/** Return true if the n entries of a and b are equal, report the first
+    one that differs otherwise. */
+static bool
+sameArray(const char *what, int n, const double *a, const double *b)
+{
+    for (int i = 0; i < n; ++i) {
+        if (a[i] != b[i]) {
+            std::cout << "  " << what << "[" << i << "]: " << a[i]
+                      << " instead of " << b[i] << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+//#############################################################################
+
+/** Compare the two readers on one file, return true if they agree. */
+static bool
+testFile(const char *fileName)
+{
+    std::cout << "Reading " << fileName << std::endl;
+
+    CoinMpsIO mps;
+    mps.messageHandler()->setLogLevel(0);
+    if (mps.readMps(fileName, "") != 0) {
+        std::cout << "  CoinMpsIO can not read the file" << std::endl;
+        return false;
+    }
+
+    BlisMpsReader reader;
+    if (reader.readMps(fileName) != 0) {
+        std::cout << "  BlisMpsReader can not read the file" << std::endl;
+        return false;
+    }
+
+    int numCols = mps.getNumCols();
+    int numRows = mps.getNumRows();
+    if (reader.getNumCols() != numCols || reader.getNumRows() != numRows) {
+        std::cout << "  size " << reader.getNumRows() << " x "
+                  << reader.getNumCols() << " instead of " << numRows
+                  << " x " << numCols << std::endl;
+        return false;
+    }
+
+    bool ok = true;
+    for (int j = 0; j < numCols; ++j) {
+        if (reader.isInteger(j) != mps.isInteger(j)) {
+            std::cout << "  integrality of column " << j << " differs"
+                      << std::endl;
+            ok = false;
+            break;
+        }
+    }
+
+    double *rowLower = NULL;
+    double *rowUpper = NULL;
+    reader.getRowBounds(rowLower, rowUpper);
+    double *colLower = reader.releaseColLower();
+    double *colUpper = reader.releaseColUpper();
+    double *objective = reader.releaseObjective();
+    CoinPackedMatrix *matrix = reader.releaseMatrix();
+
+    ok = sameArray("column lower", numCols, colLower,
+                   mps.getColLower()) && ok;
+    ok = sameArray("column upper", numCols, colUpper,
+                   mps.getColUpper()) && ok;
+    ok = sameArray("row lower", numRows, rowLower, mps.getRowLower()) && ok;
+    ok = sameArray("row upper", numRows, rowUpper, mps.getRowUpper()) && ok;
+    ok = sameArray("objective", numCols, objective,
+                   mps.getObjCoefficients()) && ok;
+    if (!matrix->isEquivalent(*mps.getMatrixByCol())) {
+        std::cout << "  matrix differs" << std::endl;
+        ok = false;
+    }
+
+    delete matrix;
+    delete [] objective;
+    delete [] colUpper;
+    delete [] colLower;
+    delete [] rowUpper;
+    delete [] rowLower;
+
+    std::cout << (ok ? "  ok" : "  FAILED") << std::endl;
+    return ok;
+}
+
+//#############################################################################
+
+int main(int argc, char *argv[])
+{
+    int numFailed = 0;
+    for (int k = 1; k < argc; ++k) {
+        if (!testFile(argv[k])) {
+            ++numFailed;
+        }
+    }
+    return numFailed;
+}
+
+//#############################################################################
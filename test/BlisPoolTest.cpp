@@ -0,0 +1,110 @@
+/*===========================================================================*
+ * This file is part of the Bcps Linear Solver (BLIS).                       *
+ *                                                                           *
+ * BLIS is distributed under the Eclipse Public License as part of the       *
+ * COIN-OR repository (http://www.coin-or.org).                              *
+ *                                                                           *
+ * Authors:                                                                  *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *                                                                           *
+ * Conceptual Design:                                                        *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *          Laszlo Ladanyi, IBM T.J. Watson Research Center                  *
+ *          Matthew Saltzman, Clemson University                             *
+ *                                                                           *
+ *                                                                           *
+ * Copyright (C) 2001-2017, Lehigh University, Yan Xu, and Ted Ralphs.       *
+ * All Rights Reserved.                                                      *
+ *===========================================================================*/
+
+// Check that BlisModel::prunePoolNodes fathoms the candidate and evaluated
+// pool nodes a cutoff dominates and leaves the others alone. Return the
+// number of failed checks.
+
+#include <iostream>
+
+#include "Alps.h"
+
+#include "BlisModel.h"
+#include "BlisTreeNode.h"
+
+//#############################################################################
+
+/** Report a failed check, return 1 if it failed and 0 otherwise. */
+static int
+check(bool ok, const char *what)
+{
+    if (!ok) {
+        std::cout << "  FAILED: " << what << std::endl;
+    }
+    return ok ? 0 : 1;
+}
+
+//#############################################################################
+
+int main()
+{
+    int numFailed = 0;
+
+    std::cout << "Pruning pool nodes" << std::endl;
+
+    BlisModel model;
+
+    const int numNodes = 5;
+    const double quality[numNodes] = { 5.0, 9.99995, 12.0, 11.0, 10.0 };
+    const AlpsNodeStatus status[numNodes] = {
+        AlpsNodeStatusCandidate,
+        AlpsNodeStatusEvaluated,
+        AlpsNodeStatusCandidate,
+        AlpsNodeStatusPregnant,
+        AlpsNodeStatusCandidate
+    };
+
+    BlisTreeNode *nodes[numNodes];
+    int k;
+    for (k = 0; k < numNodes; ++k) {
+        nodes[k] = new BlisTreeNode(&model);
+        nodes[k]->setQuality(quality[k]);
+        nodes[k]->setStatus(status[k]);
+        model.addPoolNode(nodes[k]);
+    }
+
+    // Without a cutoff nothing is dominated.
+    numFailed += check(model.prunePoolNodes(ALPS_OBJ_MAX) == 0,
+                       "nodes pruned without a cutoff");
+
+    // Within the absolute gap of the cutoff, above it and equal to it
+    // are dominated. Pregnant nodes are being branched, they stay.
+    numFailed += check(model.prunePoolNodes(10.0) == 3,
+                       "number of nodes pruned by cutoff 10");
+    numFailed += check(nodes[0]->getStatus() == AlpsNodeStatusCandidate,
+                       "node below the cutoff stays a candidate");
+    numFailed += check(nodes[1]->getStatus() == AlpsNodeStatusFathomed,
+                       "evaluated node within the gap is fathomed");
+    numFailed += check(nodes[2]->getStatus() == AlpsNodeStatusFathomed,
+                       "candidate above the cutoff is fathomed");
+    numFailed += check(nodes[3]->getStatus() == AlpsNodeStatusPregnant,
+                       "pregnant node is left alone");
+    numFailed += check(nodes[4]->getStatus() == AlpsNodeStatusFathomed,
+                       "candidate at the cutoff is fathomed");
+
+    // Fathomed nodes are not counted again.
+    numFailed += check(model.prunePoolNodes(10.0) == 0,
+                       "fathomed nodes pruned twice");
+
+    for (k = 0; k < numNodes; ++k) {
+        model.removePoolNode(nodes[k], false);
+        delete nodes[k];
+    }
+    numFailed += check(model.getPoolMemory() == 0,
+                       "pool memory released");
+
+    std::cout << (numFailed == 0 ? "  ok" : "  FAILED") << std::endl;
+    return numFailed;
+}
+
+//#############################################################################
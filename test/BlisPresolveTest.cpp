@@ -0,0 +1,226 @@
+/*===========================================================================*
+ * This file is part of the Bcps Linear Solver (BLIS).                       *
+ *                                                                           *
+ * BLIS is distributed under the Eclipse Public License as part of the       *
+ * COIN-OR repository (http://www.coin-or.org).                              *
+ *                                                                           *
+ * Authors:                                                                  *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *                                                                           *
+ * Conceptual Design:                                                        *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *          Laszlo Ladanyi, IBM T.J. Watson Research Center                  *
+ *          Matthew Saltzman, Clemson University                             *
+ *                                                                           *
+ *                                                                           *
+ * Copyright (C) 2001-2017, Lehigh University, Yan Xu, and Ted Ralphs.       *
+ * All Rights Reserved.                                                      *
+ *===========================================================================*/
+
+
+// Check that BlisPresolve removes fixed and empty columns and singleton
+// rows, tightens implied bounds, and that postsolve together with the
+// objective offset gives back the objective of the original problem, also
+// after the postsolve data went through an encoded object. Return the
+// number of failed checks.
+
+#include <cmath>
+#include <iostream>
+
+#include "CoinFinite.hpp"
+#include "CoinPackedMatrix.hpp"
+
+#include "Alps.h"
+
+#include "BlisPresolve.h"
+
+//#############################################################################
+
+/** Report a failed check, return 1 if it failed and 0 otherwise. */
+static int
+check(bool ok, const char *what)
+{
+    if (!ok) {
+        std::cout << "  FAILED: " << what << std::endl;
+    }
+    return ok ? 0 : 1;
+}
+
+//#############################################################################
+
+/** Return the dot product of the n entries of a and b. */
+static double
+dot(int n, const double *a, const double *b)
+{
+    double sum = 0.0;
+    for (int j = 0; j < n; ++j) {
+        sum += a[j] * b[j];
+    }
+    return sum;
+}
+
+//#############################################################################
+
+int main()
+{
+    int numFailed = 0;
+
+    std::cout << "Presolving" << std::endl;
+
+    // min 3 x0 + x1 + 2 x2 - x3
+    //     x0 + x1 + x2 <= 6
+    //          x1 - x2 >= -3
+    //             2 x2 >= 1
+    // x0 = 2 continuous, x1 and x2 integer in [0, 10],
+    // x3 continuous in [0, 5] and in no row.
+    const int numCols = 4;
+    const int numRows = 3;
+    const int numElements = 6;
+    const int rowInd[numElements] = { 0, 0, 1, 0, 1, 2 };
+    const int colInd[numElements] = { 0, 1, 1, 2, 2, 2 };
+    const double elements[numElements] = { 1.0, 1.0, 1.0, 1.0, -1.0, 2.0 };
+    const double rowLower[numRows] = { -COIN_DBL_MAX, -3.0, 1.0 };
+    const double rowUpper[numRows] = { 6.0, COIN_DBL_MAX, COIN_DBL_MAX };
+    const double colLower[numCols] = { 2.0, 0.0, 0.0, 0.0 };
+    const double colUpper[numCols] = { 2.0, 10.0, 10.0, 5.0 };
+    const double objective[numCols] = { 3.0, 1.0, 2.0, -1.0 };
+    const char colType[numCols] = { 'C', 'I', 'I', 'C' };
+
+    // The column matrix has no entry of x3, give it all columns.
+    CoinPackedMatrix matrix(true, rowInd, colInd, elements, numElements);
+    matrix.setDimensions(numRows, numCols);
+
+    BlisPresolve presolve;
+    numFailed += check(presolve.presolve(matrix, colLower, colUpper,
+                                         objective, rowLower, rowUpper,
+                                         colType, 1.0, 10) == 0,
+                       "problem not reduced");
+
+    // x0 is fixed, x3 goes to its best bound and the singleton row
+    // becomes x2 >= 1.
+    numFailed += check(presolve.getNumOrigCols() == numCols &&
+                       presolve.getNumOrigRows() == numRows,
+                       "original problem size");
+    numFailed += check(presolve.getNumCols() == 2,
+                       "x0 and x3 removed");
+    numFailed += check(presolve.getNumRows() == 2,
+                       "singleton row removed");
+    numFailed += check(presolve.getObjOffset() == 1.0,
+                       "objective offset 3 * 2 - 5");
+    numFailed += check(presolve.getNumTightenedBounds() > 0,
+                       "no implied bounds tightened");
+
+    CoinPackedMatrix *redMatrix = presolve.releaseMatrix();
+    double *redLower = presolve.releaseColLower();
+    double *redUpper = presolve.releaseColUpper();
+    double *redObjective = presolve.releaseObjective();
+    double *redRowLower = presolve.releaseRowLower();
+    double *redRowUpper = presolve.releaseRowUpper();
+    char *redColType = presolve.releaseColType();
+
+    numFailed += check(redMatrix->getNumCols() == 2 &&
+                       redMatrix->getNumRows() == 2,
+                       "size of the reduced matrix");
+    numFailed += check(redLower[0] == 0.0 && redUpper[0] == 3.0,
+                       "x1 in [0, 3] by the first row and x2 >= 1");
+    numFailed += check(redLower[1] == 1.0 && redUpper[1] == 4.0,
+                       "x2 in [1, 4]");
+    numFailed += check(redColType[0] == 'I' && redColType[1] == 'I',
+                       "reduced column types");
+    numFailed += check(redRowUpper[0] == 4.0,
+                       "first row upper bound moved by x0 = 2");
+    numFailed += check(redRowLower[1] == -3.0,
+                       "second row lower bound kept");
+
+    //------------------------------------------------------
+    // Postsolve and the objective offset.
+    //------------------------------------------------------
+
+    const double x[2] = { 1.0, 2.0 };
+    double origX[numCols];
+    presolve.postsolve(x, origX);
+    numFailed += check(origX[0] == 2.0 && origX[1] == 1.0 &&
+                       origX[2] == 2.0 && origX[3] == 5.0,
+                       "postsolved solution");
+    numFailed += check(fabs(dot(2, redObjective, x) +
+                            presolve.getObjOffset() -
+                            dot(numCols, objective, origX)) < 1.0e-12,
+                       "reduced objective plus offset");
+
+    //------------------------------------------------------
+    // The postsolve data survives encoding.
+    //------------------------------------------------------
+
+    AlpsEncoded encoded(AlpsKnowledgeTypeModelGen);
+    presolve.encode(&encoded);
+
+    BlisPresolve decoded;
+    decoded.decodeToSelf(encoded);
+    numFailed += check(decoded.getNumOrigCols() == numCols &&
+                       decoded.getNumCols() == 2 &&
+                       decoded.getNumRows() == 2,
+                       "decoded problem sizes");
+    numFailed += check(decoded.getObjOffset() == presolve.getObjOffset(),
+                       "decoded objective offset");
+    double decodedX[numCols];
+    decoded.postsolve(x, decodedX);
+    int j = 0;
+    while (j < numCols && decodedX[j] == origX[j]) {
+        ++j;
+    }
+    numFailed += check(j == numCols, "decoded postsolve");
+
+    delete redMatrix;
+    delete [] redLower;
+    delete [] redUpper;
+    delete [] redObjective;
+    delete [] redRowLower;
+    delete [] redRowUpper;
+    delete [] redColType;
+
+    //------------------------------------------------------
+    // Nothing to do and infeasible problems.
+    //------------------------------------------------------
+
+    // x0 + x1 <= 1, binary.
+    const int pairInd[2] = { 0, 0 };
+    const int pairCol[2] = { 0, 1 };
+    const double pairElements[2] = { 1.0, 1.0 };
+    const double pairRowLower[1] = { -COIN_DBL_MAX };
+    const double pairRowUpper[1] = { 1.0 };
+    const double pairLower[2] = { 0.0, 0.0 };
+    const double pairUpper[2] = { 1.0, 1.0 };
+    const double pairObjective[2] = { -1.0, -1.0 };
+    const char pairType[2] = { 'B', 'B' };
+    CoinPackedMatrix pair(true, pairInd, pairCol, pairElements, 2);
+
+    BlisPresolve unchanged;
+    numFailed += check(unchanged.presolve(pair, pairLower, pairUpper,
+                                          pairObjective, pairRowLower,
+                                          pairRowUpper, pairType,
+                                          1.0, 10) == 1,
+                       "reduced a problem with nothing to do");
+
+    // 2 x0 >= 3, binary.
+    const double singleRowLower[1] = { 3.0 };
+    const double singleRowUpper[1] = { COIN_DBL_MAX };
+    const double two = 2.0;
+    const int zero = 0;
+    CoinPackedMatrix single(true, &zero, &zero, &two, 1);
+
+    BlisPresolve infeasible;
+    numFailed += check(infeasible.presolve(single, pairLower, pairUpper,
+                                           pairObjective, singleRowLower,
+                                           singleRowUpper, pairType,
+                                           1.0, 10) == -1,
+                       "infeasible singleton row not detected");
+
+    std::cout << (numFailed == 0 ? "  ok" : "  FAILED") << std::endl;
+    return numFailed;
+}
+
+//#############################################################################
@@ -0,0 +1,149 @@
+/*===========================================================================*
+ * This file is part of the Bcps Linear Solver (BLIS).                       *
+ *                                                                           *
+ * BLIS is distributed under the Eclipse Public License as part of the       *
+ * COIN-OR repository (http://www.coin-or.org).                              *
+ *                                                                           *
+ * Authors:                                                                  *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *                                                                           *
+ * Conceptual Design:                                                        *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *          Laszlo Ladanyi, IBM T.J. Watson Research Center                  *
+ *          Matthew Saltzman, Clemson University                             *
+ *                                                                           *
+ *                                                                           *
+ * Copyright (C) 2001-2017, Lehigh University, Yan Xu, and Ted Ralphs.       *
+ * All Rights Reserved.                                                      *
+ *===========================================================================*/
+
+
+// Check that BlisPropagator derives implied bounds over several passes,
+// stops after the given number of passes and detects bounds that no point
+// of a row can satisfy. Return the number of failed checks.
+
+#include <iostream>
+
+#include "CoinFinite.hpp"
+#include "CoinPackedMatrix.hpp"
+
+#include "BlisPropagator.h"
+
+//#############################################################################
+
+/** Report a failed check, return 1 if it failed and 0 otherwise. */
+static int
+check(bool ok, const char *what)
+{
+    if (!ok) {
+        std::cout << "  FAILED: " << what << std::endl;
+    }
+    return ok ? 0 : 1;
+}
+
+//#############################################################################
+
+int main()
+{
+    int numFailed = 0;
+
+    std::cout << "Propagating bounds" << std::endl;
+
+    // x0 + 2 x1      <= 4
+    // x0             >= 3
+    //      x1 +  x2  >= 2.5
+    // x0 and x1 integer, x2 continuous, all in [0, 10].
+    const int numCols = 3;
+    const int numRows = 3;
+    const int numElements = 5;
+    const int rowInd[numElements] = { 0, 0, 1, 2, 2 };
+    const int colInd[numElements] = { 0, 1, 0, 1, 2 };
+    const double elements[numElements] = { 1.0, 2.0, 1.0, 1.0, 1.0 };
+    const double rowLower[numRows] = { -COIN_DBL_MAX, 3.0, 2.5 };
+    const double rowUpper[numRows] = { 4.0, COIN_DBL_MAX, COIN_DBL_MAX };
+    const char colType[numCols] = { 'I', 'I', 'C' };
+    const double colLower[numCols] = { 0.0, 0.0, 0.0 };
+    const double colUpper[numCols] = { 10.0, 10.0, 10.0 };
+
+    CoinPackedMatrix byCol(true, rowInd, colInd, elements, numElements);
+    CoinPackedMatrix byRow;
+    byRow.reverseOrderedCopyOf(byCol);
+
+    //------------------------------------------------------
+    // One pass only sees the bounds of the first row.
+    //------------------------------------------------------
+
+    BlisPropagator onePass(byRow, byCol, rowLower, rowUpper, colType,
+                           colLower, colUpper);
+    numFailed += check(onePass.propagate(1) > 0,
+                       "bounds tightened in one pass");
+    numFailed += check(onePass.getColUpper()[0] == 4.0,
+                       "x0 <= 4 after one pass");
+    numFailed += check(onePass.getColLower()[0] == 3.0,
+                       "x0 >= 3 after one pass");
+    numFailed += check(onePass.getColUpper()[1] == 2.0,
+                       "x1 <= 2 after one pass");
+    numFailed += check(onePass.getColLower()[2] == 0.5,
+                       "x2 >= 0.5 after one pass");
+    numFailed += check(!onePass.hasPending(),
+                       "rows left queued after the pass limit");
+
+    //------------------------------------------------------
+    // More passes carry x0 >= 3 through the first row to x1,
+    // rounded down, and through the last row to x2.
+    //------------------------------------------------------
+
+    BlisPropagator prop(byRow, byCol, rowLower, rowUpper, colType,
+                        colLower, colUpper);
+    numFailed += check(prop.propagate(10) > 0,
+                       "bounds tightened in several passes");
+    numFailed += check(prop.getColLower()[0] == 3.0 &&
+                       prop.getColUpper()[0] == 4.0,
+                       "x0 in [3, 4]");
+    numFailed += check(prop.getColLower()[1] == 0.0 &&
+                       prop.getColUpper()[1] == 0.0,
+                       "x1 fixed at 0");
+    numFailed += check(prop.getColLower()[2] == 2.5 &&
+                       prop.getColUpper()[2] == 10.0,
+                       "x2 in [2.5, 10]");
+    numFailed += check(prop.getChangedUpper().size() == 2,
+                       "upper bounds of x0 and x1 reported changed");
+    numFailed += check(prop.getChangedLower().size() == 2,
+                       "lower bounds of x0 and x2 reported changed");
+
+    // Nothing is left to derive.
+    prop.clearChanges();
+    numFailed += check(prop.propagate(10) == 0,
+                       "bounds changed by a second propagation");
+
+    //------------------------------------------------------
+    // x1 >= 1 leaves x0 <= 2 by the first row, which
+    // contradicts x0 >= 3.
+    //------------------------------------------------------
+
+    BlisPropagator infeas(byRow, byCol, rowLower, rowUpper, colType,
+                          colLower, colUpper);
+    numFailed += check(infeas.tightenLower(1, 1.0),
+                       "x1 >= 1 not applied");
+    numFailed += check(!infeas.tightenLower(1, 0.5),
+                       "looser bound reported as a change");
+    numFailed += check(infeas.propagate(10) == -1,
+                       "infeasible bounds by tightening not detected");
+
+    // The same through the bounds of a node.
+    const double nodeLower[numCols] = { 0.0, 1.0, 0.0 };
+    prop.setBounds(nodeLower, colUpper);
+    numFailed += check(prop.hasPending(),
+                       "no rows queued by new node bounds");
+    numFailed += check(prop.propagate(10) == -1,
+                       "infeasible node bounds not detected");
+
+    std::cout << (numFailed == 0 ? "  ok" : "  FAILED") << std::endl;
+    return numFailed;
+}
+
+//#############################################################################
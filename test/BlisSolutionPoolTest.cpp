@@ -0,0 +1,114 @@
+/*===========================================================================*
+ * This file is part of the Bcps Linear Solver (BLIS).                       *
+ *                                                                           *
+ * BLIS is distributed under the Eclipse Public License as part of the       *
+ * COIN-OR repository (http://www.coin-or.org).                              *
+ *                                                                           *
+ * Authors:                                                                  *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *                                                                           *
+ * Conceptual Design:                                                        *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *          Laszlo Ladanyi, IBM T.J. Watson Research Center                  *
+ *          Matthew Saltzman, Clemson University                             *
+ *                                                                           *
+ *                                                                           *
+ * Copyright (C) 2001-2017, Lehigh University, Yan Xu, and Ted Ralphs.       *
+ * All Rights Reserved.                                                      *
+ *===========================================================================*/
+
+
+// Check that BlisSolutionPool drops solutions offered before, also when
+// they differ by round off or were pushed out of the elite, and that it
+// keeps the best distinct solutions in order. Return the number of failed
+// checks.
+
+#include <iostream>
+
+#include "BlisSolution.h"
+#include "BlisSolutionPool.h"
+
+//#############################################################################
+
+/** Report a failed check, return 1 if it failed and 0 otherwise. */
+static int
+check(bool ok, const char *what)
+{
+    if (!ok) {
+        std::cout << "  FAILED: " << what << std::endl;
+    }
+    return ok ? 0 : 1;
+}
+
+//#############################################################################
+
+int main()
+{
+    int numFailed = 0;
+
+    std::cout << "Pooling solutions" << std::endl;
+
+    const int size = 3;
+    const double a[size] = { 1.0, 0.0, 1.0 };
+    const double b[size] = { 0.0, 1.0, 1.0 };
+    const double c[size] = { 1.0, 1.0, 0.0 };
+    const double d[size] = { 1.0, 1.0, 1.0 };
+    const double nearA[size] = { 1.0 + 1.0e-8, 0.0, 1.0 };
+    const double nearB[size] = { 0.0, 1.0 - 1.0e-8, 1.0 };
+
+    BlisSolutionPool pool(2);
+
+    numFailed += check(pool.add(size, a, 5.0), "first solution dropped");
+    numFailed += check(!pool.add(size, a, 5.0), "same solution kept twice");
+    numFailed += check(pool.add(size, b, 3.0), "better solution dropped");
+    numFailed += check(pool.getNumSolutions() == 2 &&
+                       pool.getValue(0) == 3.0 && pool.getValue(1) == 5.0,
+                       "elite in order of value");
+
+    // A full pool pushes out its worst solution for a better one, and
+    // does not keep a worse one.
+    numFailed += check(pool.add(size, c, 4.0), "new solution dropped");
+    numFailed += check(pool.add(size, d, 7.0), "worse solution not passed on");
+    numFailed += check(pool.getNumSolutions() == 2 &&
+                       pool.getValue(0) == 3.0 && pool.getValue(1) == 4.0,
+                       "elite after a full pool");
+    numFailed += check(pool.getSolution(0)->getValue(1) == 1.0 &&
+                       pool.getSolution(1)->getValue(2) == 0.0,
+                       "elite solutions are b and c");
+
+    // Solutions no longer kept are still known, and round off below the
+    // hash precision does not make a new solution.
+    numFailed += check(!pool.add(size, a, 5.0),
+                       "solution pushed out of the elite kept again");
+    numFailed += check(!pool.add(size, d, 7.0),
+                       "solution never kept passed on again");
+    numFailed += check(!pool.add(size, nearA, 5.0),
+                       "solution with round off kept again");
+    numFailed += check(!pool.add(size, nearB, 3.0),
+                       "elite solution with round off kept again");
+    numFailed += check(pool.getNumDuplicates() == 5,
+                       "number of duplicates");
+
+    // The same point with another value is a different solution.
+    numFailed += check(pool.add(size, b, 2.0),
+                       "same point with a better value dropped");
+    numFailed += check(pool.getNumSolutions() == 2 &&
+                       pool.getValue(0) == 2.0 && pool.getValue(1) == 3.0,
+                       "elite after a better value");
+
+    // A pool without room only drops duplicates.
+    BlisSolutionPool keyOnly(0);
+    numFailed += check(keyOnly.add(size, a, 5.0) &&
+                       !keyOnly.add(size, a, 5.0) &&
+                       keyOnly.getNumSolutions() == 0,
+                       "pool without room");
+
+    std::cout << (numFailed == 0 ? "  ok" : "  FAILED") << std::endl;
+    return numFailed;
+}
+
+//#############################################################################
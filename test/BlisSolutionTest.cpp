@@ -0,0 +1,188 @@
+/*===========================================================================*
+ * This file is part of the Bcps Linear Solver (BLIS).                       *
+ *                                                                           *
+ * BLIS is distributed under the Eclipse Public License as part of the       *
+ * COIN-OR repository (http://www.coin-or.org).                              *
+ *                                                                           *
+ * Authors:                                                                  *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *                                                                           *
+ * Conceptual Design:                                                        *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *          Laszlo Ladanyi, IBM T.J. Watson Research Center                  *
+ *          Matthew Saltzman, Clemson University                             *
+ *                                                                           *
+ *                                                                           *
+ * Copyright (C) 2001-2017, Lehigh University, Yan Xu, and Ted Ralphs.       *
+ * All Rights Reserved.                                                      *
+ *===========================================================================*/
+
+
+// Check that solutions with few nonzeros are stored sparse, that the
+// stored entries survive encoding and that selectNonzeros and
+// selectFractional pick the right entries. Only the Bcps part of a
+// solution is encoded, the Alps part needs a broker. Return the number of
+// failed checks.
+
+#include <iostream>
+
+#include "Alps.h"
+#include "AlpsEncoded.h"
+
+#include "BlisSolution.h"
+
+//#############################################################################
+
+/** Report a failed check, return 1 if it failed and 0 otherwise. */
+static int
+check(bool ok, const char *what)
+{
+    if (!ok) {
+        std::cout << "  FAILED: " << what << std::endl;
+    }
+    return ok ? 0 : 1;
+}
+
+//#############################################################################
+
+/** Return true if sol has the n dense values x. */
+static bool
+sameValues(const BcpsSolution &sol, int n, const double *x)
+{
+    if (sol.getSize() != n) {
+        return false;
+    }
+    for (int j = 0; j < n; ++j) {
+        if (sol.getValue(j) != x[j]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//#############################################################################
+
+/** Return true if sol stores exactly the num entries at indices. */
+static bool
+sameEntries(const BcpsSolution &sol, int num, const int *indices)
+{
+    if (!sol.isSparse() || sol.getNumElements() != num) {
+        return false;
+    }
+    for (int k = 0; k < num; ++k) {
+        if (sol.getIndices()[k] != indices[k]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//#############################################################################
+
+int main()
+{
+    int numFailed = 0;
+
+    std::cout << "Storing solutions" << std::endl;
+
+    const int size = 10;
+    const double x[size] = { 0.0, 1.5, 0.0, 0.0, 1.0e-9,
+                             0.0, 2.0, 0.0, 0.0, 0.25 };
+    double zeroX[size];
+    for (int j = 0; j < size; ++j) {
+        zeroX[j] = (x[j] > 1.0e-6) ? x[j] : 0.0;
+    }
+
+    //------------------------------------------------------
+    // Sparse storage.
+    //------------------------------------------------------
+
+    BlisSolution sol(size, x, 7.0, 1.0e-6);
+    const int nonzeros[3] = { 1, 6, 9 };
+    numFailed += check(sameEntries(sol, 3, nonzeros),
+                       "three nonzeros stored sparse");
+    numFailed += check(sameValues(sol, size, zeroX),
+                       "values of the sparse solution");
+
+    double dense[size];
+    sol.getDenseValues(dense);
+    int j = 0;
+    while (j < size && dense[j] == zeroX[j]) {
+        ++j;
+    }
+    numFailed += check(j == size, "dense values of the sparse solution");
+
+    // Mostly nonzero is cheaper dense.
+    const double full[size] = { 1.0, 2.0, 3.0, 4.0, 5.0,
+                                6.0, 7.0, 8.0, 0.0, 0.0 };
+    BlisSolution fullSol(size, full, 1.0, 1.0e-6);
+    numFailed += check(!fullSol.isSparse() &&
+                       fullSol.getNumElements() == size &&
+                       sameValues(fullSol, size, full),
+                       "solution with eight nonzeros stored dense");
+
+    //------------------------------------------------------
+    // Encoding keeps the form.
+    //------------------------------------------------------
+
+    const double zeros[size] = { 0.0 };
+    BlisSolution zeroSol(size, zeros, 0.0, 1.0e-6);
+
+    AlpsEncoded encoded(AlpsKnowledgeTypeSolution);
+    sol.BcpsSolution::encode(&encoded);
+    fullSol.BcpsSolution::encode(&encoded);
+    zeroSol.BcpsSolution::encode(&encoded);
+
+    BlisSolution solCopy, fullCopy, zeroCopy;
+    solCopy.BcpsSolution::decodeToSelf(encoded);
+    fullCopy.BcpsSolution::decodeToSelf(encoded);
+    zeroCopy.BcpsSolution::decodeToSelf(encoded);
+
+    numFailed += check(sameEntries(solCopy, 3, nonzeros) &&
+                       sameValues(solCopy, size, zeroX) &&
+                       solCopy.getQuality() == 7.0,
+                       "decoded sparse solution");
+    numFailed += check(!fullCopy.isSparse() &&
+                       sameValues(fullCopy, size, full) &&
+                       fullCopy.getQuality() == 1.0,
+                       "decoded dense solution");
+    numFailed += check(sameEntries(zeroCopy, 0, NULL) &&
+                       sameValues(zeroCopy, size, zeros),
+                       "decoded solution without nonzeros");
+
+    //------------------------------------------------------
+    // Selection.
+    //------------------------------------------------------
+
+    BcpsSolution *nonzero = sol.selectNonzeros(1.0e-5);
+    numFailed += check(sameEntries(*nonzero, 3, nonzeros) &&
+                       sameValues(*nonzero, size, zeroX) &&
+                       nonzero->getQuality() == 7.0,
+                       "selected nonzeros");
+    delete nonzero;
+
+    BcpsSolution *fractional = sol.selectFractional(1.0e-5);
+    const int fractionals[2] = { 1, 9 };
+    numFailed += check(sameEntries(*fractional, 2, fractionals) &&
+                       fractional->getValue(1) == 1.5 &&
+                       fractional->getValue(6) == 0.0 &&
+                       fractional->getValue(9) == 0.25,
+                       "selected fractional entries");
+    delete fractional;
+
+    // Selecting from a dense solution gives a sparse one.
+    BcpsSolution *fullNonzero = fullSol.selectNonzeros(1.0e-5);
+    const int fullNonzeros[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+    numFailed += check(sameEntries(*fullNonzero, 8, fullNonzeros),
+                       "selected nonzeros of a dense solution");
+    delete fullNonzero;
+
+    std::cout << (numFailed == 0 ? "  ok" : "  FAILED") << std::endl;
+    return numFailed;
+}
+
+//#############################################################################
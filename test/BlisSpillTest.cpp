@@ -0,0 +1,190 @@
+/*===========================================================================*
+ * This file is part of the Bcps Linear Solver (BLIS).                       *
+ *                                                                           *
+ * BLIS is distributed under the Eclipse Public License as part of the       *
+ * COIN-OR repository (http://www.coin-or.org).                              *
+ *                                                                           *
+ * Authors:                                                                  *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *                                                                           *
+ * Conceptual Design:                                                        *
+ *                                                                           *
+ *          Yan Xu, Lehigh University                                        *
+ *          Ted Ralphs, Lehigh University                                    *
+ *          Laszlo Ladanyi, IBM T.J. Watson Research Center                  *
+ *          Matthew Saltzman, Clemson University                             *
+ *                                                                           *
+ *                                                                           *
+ * Copyright (C) 2001-2017, Lehigh University, Yan Xu, and Ted Ralphs.       *
+ * All Rights Reserved.                                                      *
+ *===========================================================================*/
+
+
+// Check that node descriptions spilled to a file release their
+// modifications and get them back unchanged, added cuts included, in any
+// order. Return the number of failed checks.
+
+#include <cstdio>
+#include <iostream>
+
+#include "BlisConstraint.h"
+#include "BlisNodeDesc.h"
+
+//#############################################################################
+
+/** Report a failed check, return 1 if it failed and 0 otherwise. */
+static int
+check(bool ok, const char *what)
+{
+    if (!ok) {
+        std::cout << "  FAILED: " << what << std::endl;
+    }
+    return ok ? 0 : 1;
+}
+
+//#############################################################################
+
+/** Return true if the field has the n given positions and entries. */
+static bool
+sameField(const BcpsFieldListMod<double> &field, bool relative, int n,
+          const int *pos, const double *entries)
+{
+    if (field.relative != relative || field.numModify != n) {
+        return false;
+    }
+    for (int k = 0; k < n; ++k) {
+        if (field.posModify[k] != pos[k] || field.entries[k] != entries[k]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//#############################################################################
+
+int main()
+{
+    int numFailed = 0;
+
+    std::cout << "Spilling node descriptions" << std::endl;
+
+    FILE *file = tmpfile();
+    if (!file) {
+        std::cout << "  FAILED: no temporary file" << std::endl;
+        return 1;
+    }
+
+    //------------------------------------------------------
+    // A description with variable bound changes, and one that
+    // removes an inherited cut and adds a new one.
+    //------------------------------------------------------
+
+    const int lbPos[2] = { 2, 5 };
+    const double lbVal[2] = { 1.0, 3.0 };
+    const int ubPos[1] = { 5 };
+    const double ubVal[1] = { 4.0 };
+    const int softPos[1] = { 7 };
+    const double softVal[1] = { 0.5 };
+
+    BlisNodeDesc desc;
+    desc.setVars(0, NULL, 0, NULL,
+                 true, 2, lbPos, lbVal,
+                 false, 1, ubPos, ubVal,
+                 true, 1, softPos, softVal,
+                 false, 0, NULL, NULL);
+
+    const int cutInd[3] = { 0, 4, 9 };
+    const double cutVal[3] = { 1.0, -1.0, 2.0 };
+    const int remPos[1] = { 0 };
+    const BcpsObject *cuts[1] = {
+        new BlisConstraint(-1.0, 5.0, -1.0, 5.0, 3, cutInd, cutVal)
+    };
+    const int conPos[1] = { 1 };
+    const double conVal[1] = { 2.0 };
+
+    BlisNodeDesc other;
+    other.setVars(0, NULL, 0, NULL,
+                  false, 1, ubPos, lbVal,
+                  false, 0, NULL, NULL,
+                  false, 0, NULL, NULL,
+                  false, 0, NULL, NULL);
+    other.setCons(1, remPos, 1, cuts,
+                  true, 0, NULL, NULL,
+                  true, 0, NULL, NULL,
+                  true, 0, NULL, NULL,
+                  true, 1, conPos, conVal);
+
+    size_t descMemory = desc.getMemoryUsage();
+    size_t otherMemory = other.getMemoryUsage();
+
+    //------------------------------------------------------
+    // Spill both, the second goes after the first.
+    //------------------------------------------------------
+
+    numFailed += check(desc.spill(file) == AlpsReturnStatusOk &&
+                       other.spill(file) == AlpsReturnStatusOk,
+                       "spill failed");
+    numFailed += check(desc.isSpilled() && other.isSpilled(),
+                       "descriptions not marked spilled");
+    numFailed += check(desc.getVars()->lbHard.numModify == 0 &&
+                       other.getCons()->numAdd == 0,
+                       "spilled modifications still in memory");
+    numFailed += check(desc.getMemoryUsage() < descMemory &&
+                       other.getMemoryUsage() < otherMemory,
+                       "spilled descriptions use as much memory");
+
+    // Spilling again writes nothing.
+    long end = (fseek(file, 0, SEEK_END) == 0) ? ftell(file) : -1;
+    numFailed += check(desc.spill(file) == AlpsReturnStatusOk &&
+                       fseek(file, 0, SEEK_END) == 0 && ftell(file) == end,
+                       "spilled description written twice");
+
+    //------------------------------------------------------
+    // Read them back in the other order.
+    //------------------------------------------------------
+
+    numFailed += check(other.unspill(file) == AlpsReturnStatusOk &&
+                       desc.unspill(file) == AlpsReturnStatusOk,
+                       "unspill failed");
+    numFailed += check(!desc.isSpilled() && !other.isSpilled(),
+                       "descriptions still marked spilled");
+    numFailed += check(desc.getMemoryUsage() == descMemory &&
+                       other.getMemoryUsage() == otherMemory,
+                       "memory after unspill");
+
+    BcpsObjectListMod *vars = desc.getVars();
+    numFailed += check(sameField(vars->lbHard, true, 2, lbPos, lbVal) &&
+                       sameField(vars->ubHard, false, 1, ubPos, ubVal) &&
+                       sameField(vars->lbSoft, true, 1, softPos, softVal) &&
+                       sameField(vars->ubSoft, false, 0, NULL, NULL),
+                       "variable bounds after unspill");
+
+    numFailed += check(sameField(other.getVars()->lbHard, false, 1,
+                                 ubPos, lbVal),
+                       "bounds of the second description after unspill");
+
+    BcpsObjectListMod *cons = other.getCons();
+    numFailed += check(cons->numRemove == 1 && cons->posRemove[0] == 0,
+                       "removed cut after unspill");
+    numFailed += check(sameField(cons->ubSoft, true, 1, conPos, conVal),
+                       "cut bounds after unspill");
+
+    const BlisConstraint *cut = (cons->numAdd == 1) ?
+        dynamic_cast<const BlisConstraint *>(cons->objects[0]) : NULL;
+    bool sameCut = (cut != NULL && cut->getSize() == 3 &&
+                    cut->getLbHard() == -1.0 && cut->getUbHard() == 5.0);
+    for (int k = 0; sameCut && k < 3; ++k) {
+        sameCut = (cut->getIndices()[k] == cutInd[k] &&
+                   cut->getValues()[k] == cutVal[k]);
+    }
+    numFailed += check(sameCut, "added cut after unspill");
+
+    fclose(file);
+
+    std::cout << (numFailed == 0 ? "  ok" : "  FAILED") << std::endl;
+    return numFailed;
+}
+
+//#############################################################################
@@ -0,0 +1,21 @@
+*NAME:         intorg
+*COMMENTS:     X1 is integer by marker and has no BOUNDS entry, so its
+*              upper bound is 1.0. X2 is integer with an explicit upper
+*              bound, X3 is continuous and unbounded above.
+NAME          INTORG
+ROWS
+ N  COST
+ L  LIM1
+ G  LIM2
+COLUMNS
+    MARKER                 'MARKER'                 'INTORG'
+    X1        COST              -1.0   LIM1               1.0
+    X2        COST              -2.0   LIM1               1.0
+    X2        LIM2               1.0
+    MARKER                 'MARKER'                 'INTEND'
+    X3        COST               1.0   LIM2               1.0
+RHS
+    RHS       LIM1               4.0   LIM2               1.0
+BOUNDS
+ UP BND       X2                 3.0
+ENDATA